@@ -0,0 +1,55 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Threads for work that runs alongside the reads of the caller, such as 
+// prefetching blocks. One set is shared by all bands of a dataset, so that
+// the number of threads does not grow with the number of bands.
+//
+// Unlike thread_pool, which runs a parallel_for while the caller waits, 
+// tasks are queued and run in order of submission.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    class background_workers
+    {
+    public:
+      explicit background_workers(int num_threads);
+
+      // Runs the tasks that are still queued before joining the threads.
+      ~background_workers();
+
+      background_workers(const background_workers&) = delete;
+      background_workers& operator=(const background_workers&) = delete;
+
+      int num_threads() const;
+
+      // Queues a task for one of the threads. The task must not throw.
+      void submit(std::function<void()> task);
+
+    private:
+      void worker_loop();
+
+      std::vector<std::thread> m_workers;
+      std::mutex m_mutex;
+      std::condition_variable m_work;
+      std::deque<std::function<void()>> m_tasks;
+      bool m_stop = false;
+    };
+
+  } // namespace raster
+} // namespace pronto
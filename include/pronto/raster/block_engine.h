@@ -0,0 +1,126 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Creates the random engine used to fill one block. The engine is keyed on
+// (seed, stream, block index), where the stream distinguishes the bands of a
+// dataset. Each supported engine gets its own way of turning the key into
+// engine state:
+//  - counter-based engines use the key directly, which costs nothing;
+//  - xoshiro256++ is seeded from a hash of the key;
+//  - PCG64 takes its state from a hash of the key and uses the block (or
+//    pixel) index as the increment, so that streams differ in both;
+//  - standard library engines are seeded with seed + block index, as in
+//    earlier versions of the driver.
+//
+// Engines that can be set up cheaply also provide make_for_pixel, keyed on
+// (seed, stream, row, col), which is used for pixel addressing: every value
+// then only depends on its position and not on the blocking of the raster.
+
+#pragma once
+
+#include <pronto/raster/pcg64_engine.h>
+#include <pronto/raster/philox_engine.h>
+#include <pronto/raster/splitmix64.h>
+#include <pronto/raster/threefry_engine.h>
+#include <pronto/raster/xoshiro256pp_engine.h>
+
+#include <cstdint>
+
+namespace pronto {
+  namespace raster {
+
+    // Unique index for each pixel of a raster with at most 2^32 columns.
+    inline uint64_t pixel_index(int row, int col)
+    {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32)
+        | static_cast<uint32_t>(col);
+    }
+
+    template<class Generator>
+    struct block_engine
+    {
+      static constexpr bool pixel_addressable = false;
+
+      static Generator make(uint64_t seed, uint64_t stream, uint64_t block_index)
+      {
+        // splitmix64::mix(0) == 0, so the first stream keeps the legacy seeds
+        return Generator((seed ^ splitmix64::mix(stream)) + block_index);
+      }
+    };
+
+    template<>
+    struct block_engine<philox4x64_engine>
+    {
+      static philox4x64_engine make(uint64_t seed, uint64_t stream, uint64_t block_index)
+      {
+        return philox4x64_engine(seed, stream, block_index);
+      }
+
+      static constexpr bool pixel_addressable = true;
+
+      static philox4x64_engine make_for_pixel(uint64_t seed, uint64_t stream, int row, int col)
+      {
+        return philox4x64_engine(seed, stream, static_cast<uint64_t>(row), static_cast<uint64_t>(col), 1);
+      }
+    };
+
+    template<>
+    struct block_engine<threefry4x64_engine>
+    {
+      static threefry4x64_engine make(uint64_t seed, uint64_t stream, uint64_t block_index)
+      {
+        return threefry4x64_engine(seed, stream, block_index);
+      }
+
+      static constexpr bool pixel_addressable = true;
+
+      static threefry4x64_engine make_for_pixel(uint64_t seed, uint64_t stream, int row, int col)
+      {
+        return threefry4x64_engine(seed, stream, static_cast<uint64_t>(row), static_cast<uint64_t>(col), 1);
+      }
+    };
+
+    template<>
+    struct block_engine<xoshiro256pp_engine>
+    {
+      static xoshiro256pp_engine make(uint64_t seed, uint64_t stream, uint64_t block_index)
+      {
+        const uint64_t key = splitmix64::mix(seed) ^ splitmix64::mix(~stream);
+        return xoshiro256pp_engine(splitmix64::mix(key + block_index));
+      }
+
+      static constexpr bool pixel_addressable = true;
+
+      static xoshiro256pp_engine make_for_pixel(uint64_t seed, uint64_t stream, int row, int col)
+      {
+        const uint64_t key = splitmix64::mix(seed) ^ splitmix64::mix(~stream);
+        return xoshiro256pp_engine(key ^ splitmix64::mix(pixel_index(row, col)));
+      }
+    };
+
+    template<>
+    struct block_engine<pcg64_engine>
+    {
+      static pcg64_engine make(uint64_t seed, uint64_t stream, uint64_t block_index)
+      {
+        const uint64_t state = splitmix64::mix(seed ^ splitmix64::mix(stream) ^ splitmix64::mix(block_index));
+        return pcg64_engine(state, block_index);
+      }
+
+      static constexpr bool pixel_addressable = true;
+
+      static pcg64_engine make_for_pixel(uint64_t seed, uint64_t stream, int row, int col)
+      {
+        const uint64_t index = pixel_index(row, col);
+        const uint64_t state = splitmix64::mix(seed ^ splitmix64::mix(stream) ^ splitmix64::mix(index));
+        return pcg64_engine(state, index);
+      }
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -11,12 +11,43 @@
    
 #pragma once
 
+#include <pronto/raster/value_distribution.h>
+
+#include <cstddef>
+
 namespace pronto {
   namespace raster {
     class block_generator_interface {
     public:
       virtual ~block_generator_interface() = default;
       virtual void fill_block(int major_row, int major_col, void* block, size_t block_size) = 0;
+
+      // Fills the window of rows x cols pixels starting at (first_row, 
+      // first_col) with the same values as fill_block. The value of pixel 
+      // (first_row + r, first_col + c) is written at byte offset 
+      // r * line_space + c * pixel_space of buffer, in the data type of the 
+      // generator.
+      virtual void fill_window(int first_row, int first_col, int rows, int cols, void* buffer,
+        std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) = 0;
+
+      // True if every value can be generated on its own, i.e. with pixel
+      // addressing, so that fill_sampled is available.
+      virtual bool pixel_addressable() const = 0;
+
+      // Fills the buffer with the values at the intersections of the given
+      // rows and columns. The value of (rows[r], cols[c]) is written at byte
+      // offset r * line_space + c * pixel_space of buffer. Requires 
+      // pixel_addressable().
+      virtual void fill_sampled(const int* rows, int num_rows, const int* cols, int num_cols,
+        void* buffer, std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) = 0;
+
+      // Distribution of the generated values, from which the statistics
+      // below are derived.
+      virtual const value_distribution& get_value_distribution() const = 0;
+
+      // The expected extremes of the raster where the values are unbounded,
+      // see value_distribution::expected_min. The mean and standard
+      // deviation are NaN when they are not defined.
       virtual double get_min() const = 0;
       virtual double get_max() const = 0;
       virtual double get_mean() const = 0;
@@ -0,0 +1,92 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Read-ahead of blocks for consumers that walk the raster block by block. 
+//
+// Once two consecutive blocks (in row major order) have been read, the 
+// next depth blocks are generated on the background workers of the dataset
+// into a ring buffer of depth + 1 blocks, so that generation overlaps with 
+// the work of the consumer. Blocks that are read while they are still being
+// generated are waited for, other blocks are generated on the calling 
+// thread.
+
+#pragma once
+
+#include <pronto/raster/background_workers.h>
+#include <pronto/raster/block_generator_interface.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    class block_prefetcher
+    {
+    public:
+      block_prefetcher(block_generator_interface* generator, int blocks_in_row, int blocks_in_column,
+        std::size_t values_in_block, std::size_t bytes_in_block, int depth, background_workers& workers);
+
+      // Waits for the tasks submitted to the workers.
+      ~block_prefetcher();
+
+      block_prefetcher(const block_prefetcher&) = delete;
+      block_prefetcher& operator=(const block_prefetcher&) = delete;
+
+      // Reads a block, from the ring buffer if it has been prefetched.
+      void read_block(int major_row, int major_col, void* block);
+
+      // Number of blocks that were read from the ring buffer.
+      uint64_t hits() const;
+
+      // Number of blocks that were generated on the calling thread.
+      uint64_t misses() const;
+
+    private:
+      enum class slot_state { empty, queued, generating, ready };
+
+      struct slot
+      {
+        int64_t index = -1;
+        slot_state state = slot_state::empty;
+        std::vector<unsigned char> data;
+      };
+
+      // Queues a block, returns whether a task must be submitted for it.
+      bool schedule(int64_t index);
+
+      // Generates the block at the front of the queue, if any.
+      void run_task();
+
+      block_generator_interface* m_generator;
+      int m_blocks_in_row;
+      int64_t m_block_count;
+      std::size_t m_values_in_block;
+      std::size_t m_bytes_in_block;
+      int m_depth;
+      background_workers& m_workers;
+
+      std::vector<slot> m_slots;
+      std::deque<std::size_t> m_queue;
+      int64_t m_last_index = -2;
+      uint64_t m_hits = 0;
+      uint64_t m_misses = 0;
+
+      mutable std::mutex m_mutex;
+      std::condition_variable m_ready;
+      std::condition_variable m_idle;
+      std::size_t m_pending_tasks = 0;
+      bool m_stop = false;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,119 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Fills ranges of a block with values drawn from a distribution. The primary
+// template draws the values one by one from the standard library
+// distribution (distribution_block_sampler). Specializations for particular
+// distributions replace this by batched kernels that process a chunk of raw
+// engine output at a time, and can fall back on distribution_block_sampler.
+//
+// A block_sampler is immutable after construction, so a single instance can
+// be shared by all blocks.
+//
+// With pixel addressing every value has its own engine. Samplers that take
+// one 64-bit word per value, and only draw further words for the few values
+// that are rejected, can then provide
+//
+//   template<class EngineOf>
+//   void fill_streams(const uint64_t* first_draws, EngineOf engine_of,
+//     TargetGdalType* out, std::size_t n) const;
+//
+// which sets out[i], n <= sampler_chunk_size, to the value that fill gives
+// for a single value with the fresh engine engine_of(i), whose first output
+// is first_draws[i]. The kernels then process a chunk of pixels at once.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace pronto {
+  namespace raster {
+
+    // Number of values processed per batch by the batched samplers. Chosen so
+    // that the intermediate buffers comfortably fit in the L1 cache.
+    constexpr std::size_t sampler_chunk_size = 1024;
+
+    // Uniform value in [0, 1) from the 53 high bits.
+    inline double unit_interval(uint64_t bits)
+    {
+      return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+
+    // Uniform value in (0, 1] from the 53 high bits, safe to take the log of.
+    inline double positive_unit_interval(uint64_t bits)
+    {
+      return static_cast<double>((bits >> 11) + 1) * 0x1.0p-53;
+    }
+
+    // Fills a range with raw 64-bit engine output.
+    template<class Generator>
+    void fill_bits(Generator& rng, uint64_t* first, uint64_t* last)
+    {
+      static_assert(Generator::min() == 0
+        && Generator::max() == std::numeric_limits<uint64_t>::max(),
+        "Batched samplers require an engine producing 64 random bits per call");
+      for (; first != last; ++first) {
+        *first = rng();
+      }
+    }
+
+    // Draws the values one by one from the standard library distribution.
+    template<class Distribution, typename TargetGdalType>
+    class distribution_block_sampler
+    {
+    public:
+      explicit distribution_block_sampler(const Distribution& distribution)
+        : m_distribution(distribution)
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        // Distributions can carry state between calls (e.g. the cached second
+        // value of std::normal_distribution), use a fresh copy so that the
+        // range does not depend on previously generated ranges.
+        Distribution distribution = m_distribution;
+        std::generate(first, last, [&]() {
+          return static_cast<TargetGdalType>(distribution(rng));
+          });
+      }
+
+      const Distribution& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      Distribution m_distribution;
+    };
+
+    template<class Distribution, typename TargetGdalType>
+    class block_sampler : public distribution_block_sampler<Distribution, TargetGdalType>
+    {
+    public:
+      using distribution_block_sampler<Distribution, TargetGdalType>::distribution_block_sampler;
+    };
+
+    // Whether Sampler provides fill_streams for engines of type Generator.
+    template<class Sampler, typename TargetGdalType, class Generator, class = void>
+    struct has_fill_streams : std::false_type {};
+
+    template<class Sampler, typename TargetGdalType, class Generator>
+    struct has_fill_streams<Sampler, TargetGdalType, Generator,
+      std::void_t<decltype(std::declval<const Sampler&>().fill_streams(std::declval<const uint64_t*>(),
+        std::declval<Generator(*)(std::size_t)>(), std::declval<TargetGdalType*>(), std::size_t{}))>>
+      : std::true_type {};
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,70 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Procedural gradient noise (Perlin or simplex), optionally summed over
+// octaves as fractal Brownian motion. Octave k has the frequency 
+// lacunarity^k / scale and the weight gain^k, and the weighted sum is 
+// divided by the sum of the weights, so that the noise lies in [-1, 1]. The
+// value of a cell is mean + amplitude * noise, evaluated at its centre.
+//
+// Every value is a pure function of the position of the cell, evaluated row
+// by row with the perlin_noise and simplex_noise kernels, so the field is 
+// pixel addressable and has cheap overviews.
+
+#pragma once
+
+#include <pronto/raster/spatial_field.h>
+#include <pronto/raster/value_distribution.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    enum class noise_basis {
+      perlin,
+      simplex
+    };
+
+    class coherent_noise_field : public spatial_field
+    {
+    public:
+      // scale is the size in cells of the lattice of the first octave. 
+      // rows and cols are the size of the raster, which must fit on the 
+      // lattice of the last octave.
+      coherent_noise_field(uint64_t seed, uint64_t stream, int rows, int cols, noise_basis basis,
+        double mean, double amplitude, double scale, int octaves, double lacunarity, double gain);
+
+      void generate(int first_row, int first_col, int rows, int cols, double* values,
+        std::ptrdiff_t line_stride) const override;
+
+      bool pixel_addressable() const override;
+
+      const value_distribution& get_value_distribution() const override;
+
+    private:
+      struct octave
+      {
+        uint32_t seed;
+        double frequency;
+        double weight;
+        double x_offset; // shifts the lattice, in lattice units
+        double y_offset;
+      };
+
+      noise_basis m_basis;
+      double m_mean;
+      double m_amplitude;
+      std::vector<octave> m_octaves;
+      value_distribution m_values; // unknown
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,358 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Cumulative distribution functions of the continuous standard library
+// distributions, and their numerical inversion. These are only evaluated
+// when a dataset is opened, to build the table of inverse_cdf_sampler.
+//
+// continuous_cdf<Distribution> provides cdf(distribution, x) and the
+// support [lower, upper] of the distribution; available is false for
+// distributions that have no specialization.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    // Regularized lower incomplete gamma function P(a, x), using the series
+    // expansion below a + 1 and the continued fraction above it.
+    inline double regularized_gamma_p(double a, double x)
+    {
+      if (x <= 0.0) return 0.0;
+      const double log_prefix = a * std::log(x) - x - std::lgamma(a);
+      if (x < a + 1.0) {
+        double term = 1.0 / a;
+        double sum = term;
+        for (int n = 1; n < 1000; ++n) {
+          term *= x / (a + n);
+          sum += term;
+          if (std::abs(term) < std::abs(sum) * 1e-16) break;
+        }
+        return std::min(1.0, sum * std::exp(log_prefix));
+      }
+      // Modified Lentz's method for the continued fraction of Q(a, x)
+      const double tiny = 1e-300;
+      double b = x + 1.0 - a;
+      double c = 1.0 / tiny;
+      double d = 1.0 / b;
+      double h = d;
+      for (int n = 1; n < 1000; ++n) {
+        const double an = -n * (n - a);
+        b += 2.0;
+        d = an * d + b;
+        if (std::abs(d) < tiny) d = tiny;
+        c = b + an / c;
+        if (std::abs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        const double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < 1e-16) break;
+      }
+      return std::max(0.0, 1.0 - std::exp(log_prefix) * h);
+    }
+
+    // Regularized incomplete beta function I_x(a, b), using the continued
+    // fraction on whichever side converges fastest.
+    inline double regularized_beta(double x, double a, double b)
+    {
+      if (x <= 0.0) return 0.0;
+      if (x >= 1.0) return 1.0;
+      if (x > (a + 1.0) / (a + b + 2.0)) {
+        return 1.0 - regularized_beta(1.0 - x, b, a);
+      }
+      const double log_prefix = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b)
+        + a * std::log(x) + b * std::log1p(-x);
+
+      // Modified Lentz's method
+      const double tiny = 1e-300;
+      double c = 1.0;
+      double d = 1.0 - (a + b) * x / (a + 1.0);
+      if (std::abs(d) < tiny) d = tiny;
+      d = 1.0 / d;
+      double h = d;
+      for (int m = 1; m < 1000; ++m) {
+        const double even = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+        d = 1.0 + even * d;
+        if (std::abs(d) < tiny) d = tiny;
+        c = 1.0 + even / c;
+        if (std::abs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        h *= d * c;
+
+        const double odd = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+        d = 1.0 + odd * d;
+        if (std::abs(d) < tiny) d = tiny;
+        c = 1.0 + odd / c;
+        if (std::abs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        const double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < 1e-16) break;
+      }
+      return std::min(1.0, std::exp(log_prefix) * h / a);
+    }
+
+    template<class Distribution>
+    struct continuous_cdf
+    {
+      static constexpr bool available = false;
+    };
+
+    // Support on the whole real line, for the specializations below.
+    struct unbounded_support
+    {
+      static constexpr bool available = true;
+
+      template<class Distribution>
+      static double lower(const Distribution&)
+      {
+        return -std::numeric_limits<double>::infinity();
+      }
+
+      template<class Distribution>
+      static double upper(const Distribution&)
+      {
+        return std::numeric_limits<double>::infinity();
+      }
+    };
+
+    // Support on [0, infinity), for the specializations below.
+    struct positive_support
+    {
+      static constexpr bool available = true;
+
+      template<class Distribution>
+      static double lower(const Distribution&)
+      {
+        return 0.0;
+      }
+
+      template<class Distribution>
+      static double upper(const Distribution&)
+      {
+        return std::numeric_limits<double>::infinity();
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::uniform_real_distribution<T>>
+    {
+      static constexpr bool available = true;
+      static double lower(const std::uniform_real_distribution<T>& d) { return d.a(); }
+      static double upper(const std::uniform_real_distribution<T>& d) { return d.b(); }
+      static double cdf(const std::uniform_real_distribution<T>& d, double x)
+      {
+        return std::clamp((x - d.a()) / (d.b() - d.a()), 0.0, 1.0);
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::normal_distribution<T>> : unbounded_support
+    {
+      static double cdf(const std::normal_distribution<T>& d, double x)
+      {
+        return 0.5 * std::erfc(-(x - d.mean()) / (d.stddev() * std::sqrt(2.0)));
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::lognormal_distribution<T>> : positive_support
+    {
+      static double cdf(const std::lognormal_distribution<T>& d, double x)
+      {
+        if (x <= 0.0) return 0.0;
+        return 0.5 * std::erfc(-(std::log(x) - d.m()) / (d.s() * std::sqrt(2.0)));
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::gamma_distribution<T>> : positive_support
+    {
+      static double cdf(const std::gamma_distribution<T>& d, double x)
+      {
+        return regularized_gamma_p(d.alpha(), x / d.beta());
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::exponential_distribution<T>> : positive_support
+    {
+      static double cdf(const std::exponential_distribution<T>& d, double x)
+      {
+        return x <= 0.0 ? 0.0 : -std::expm1(-d.lambda() * x);
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::weibull_distribution<T>> : positive_support
+    {
+      static double cdf(const std::weibull_distribution<T>& d, double x)
+      {
+        return x <= 0.0 ? 0.0 : -std::expm1(-std::pow(x / d.b(), d.a()));
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::extreme_value_distribution<T>> : unbounded_support
+    {
+      static double cdf(const std::extreme_value_distribution<T>& d, double x)
+      {
+        return std::exp(-std::exp(-(x - d.a()) / d.b()));
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::cauchy_distribution<T>> : unbounded_support
+    {
+      static double cdf(const std::cauchy_distribution<T>& d, double x)
+      {
+        const double pi = 3.14159265358979323846;
+        return 0.5 + std::atan((x - d.a()) / d.b()) / pi;
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::chi_squared_distribution<T>> : positive_support
+    {
+      static double cdf(const std::chi_squared_distribution<T>& d, double x)
+      {
+        return regularized_gamma_p(0.5 * d.n(), 0.5 * x);
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::student_t_distribution<T>> : unbounded_support
+    {
+      static double cdf(const std::student_t_distribution<T>& d, double x)
+      {
+        const double n = d.n();
+        const double tail = 0.5 * regularized_beta(n / (n + x * x), 0.5 * n, 0.5);
+        return x < 0.0 ? tail : 1.0 - tail;
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::fisher_f_distribution<T>> : positive_support
+    {
+      static double cdf(const std::fisher_f_distribution<T>& d, double x)
+      {
+        if (x <= 0.0) return 0.0;
+        const double mx = d.m() * x;
+        return regularized_beta(mx / (mx + d.n()), 0.5 * d.m(), 0.5 * d.n());
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::piecewise_constant_distribution<T>>
+    {
+      static constexpr bool available = true;
+      static double lower(const std::piecewise_constant_distribution<T>& d) { return d.intervals().front(); }
+      static double upper(const std::piecewise_constant_distribution<T>& d) { return d.intervals().back(); }
+      static double cdf(const std::piecewise_constant_distribution<T>& d, double x)
+      {
+        const std::vector<T> intervals = d.intervals();
+        const std::vector<double> densities = d.densities();
+        double sum = 0.0;
+        for (std::size_t i = 0; i < densities.size(); ++i) {
+          const double from = intervals[i];
+          const double to = intervals[i + 1];
+          if (x <= from) break;
+          sum += densities[i] * (std::min(x, to) - from);
+        }
+        return std::min(sum, 1.0);
+      }
+    };
+
+    template<typename T>
+    struct continuous_cdf<std::piecewise_linear_distribution<T>>
+    {
+      static constexpr bool available = true;
+      static double lower(const std::piecewise_linear_distribution<T>& d) { return d.intervals().front(); }
+      static double upper(const std::piecewise_linear_distribution<T>& d) { return d.intervals().back(); }
+      static double cdf(const std::piecewise_linear_distribution<T>& d, double x)
+      {
+        const std::vector<T> intervals = d.intervals();
+        const std::vector<double> densities = d.densities();
+        double sum = 0.0;
+        for (std::size_t i = 0; i + 1 < intervals.size(); ++i) {
+          const double from = intervals[i];
+          const double to = intervals[i + 1];
+          if (x <= from) break;
+          const double end = std::min(x, to);
+          const double slope = (densities[i + 1] - densities[i]) / (to - from);
+          const double width = end - from;
+          sum += width * (densities[i] + 0.5 * slope * width);
+        }
+        return std::min(sum, 1.0);
+      }
+    };
+
+    // Finds x with cdf(x) = p by the Illinois variant of regula falsi,
+    // starting from a bracket that is expanded until it contains p.
+    // lower_hint must be a value with cdf(lower_hint) <= p, e.g. the
+    // quantile of a smaller probability, and upper_hint, if finite, a value
+    // with cdf(upper_hint) >= p.
+    template<class Distribution>
+    double inverse_cdf(const Distribution& distribution, double p, double lower_hint,
+      double upper_hint = std::numeric_limits<double>::infinity())
+    {
+      using cdf_type = continuous_cdf<Distribution>;
+      const double lower = cdf_type::lower(distribution);
+      const double upper = cdf_type::upper(distribution);
+
+      double a = std::isfinite(lower_hint) ? lower_hint
+        : std::isfinite(lower) ? lower : std::min(upper, 0.0) - 1.0;
+      double fa = cdf_type::cdf(distribution, a) - p;
+      for (double step = 1.0; fa > 0.0; step *= 2.0) {
+        a -= step;
+        fa = cdf_type::cdf(distribution, a) - p;
+      }
+
+      double b = std::isfinite(upper_hint) ? upper_hint : std::isfinite(upper) ? upper : a + 1.0;
+      double fb = cdf_type::cdf(distribution, b) - p;
+      for (double step = 1.0; fb < 0.0; step *= 2.0) {
+        a = b;
+        fa = fb;
+        b += step;
+        fb = cdf_type::cdf(distribution, b) - p;
+      }
+
+      int side = 0;
+      for (int iteration = 0; iteration < 200; ++iteration) {
+        if (fb == fa) break;
+        double c = (a * fb - b * fa) / (fb - fa);
+        if (!(c > a && c < b)) c = 0.5 * (a + b); // guard against round-off
+        if (c == a || c == b) break;
+        const double fc = cdf_type::cdf(distribution, c) - p;
+        if (fc == 0.0) return c;
+        if (fc > 0.0) {
+          b = c;
+          fb = fc;
+          if (side == -1) fa *= 0.5;
+          side = -1;
+        }
+        else {
+          a = c;
+          fa = fc;
+          if (side == 1) fb *= 0.5;
+          side = 1;
+        }
+        if (b - a <= 4 * std::numeric_limits<double>::epsilon() * std::max(std::abs(a), std::abs(b))) break;
+      }
+      return 0.5 * (a + b);
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,302 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Batched samplers for std::poisson_distribution,
+// std::binomial_distribution, std::geometric_distribution and
+// std::negative_binomial_distribution.
+//
+// The cumulative probabilities are tabulated when the dataset is opened,
+// over the range of values outside of which the probability is below 2^-60.
+// Values are drawn by inversion of a uniform draw, starting the search from
+// a guide table (Chen and Asau 1974), so that on average fewer than two
+// comparisons are needed. When the table would exceed max_entries (e.g. a
+// Poisson mean in the tens of thousands) the samplers fall back on the
+// standard library distribution.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    class count_cdf_table
+    {
+    public:
+      static constexpr std::size_t max_entries = 4096;
+
+      // Tabulates the distribution with the given log probability mass
+      // function, which has its mode at mode, on support [support_min,
+      // support_max]. The ratio pmf(k + 1) / pmf(k) must be decreasing, or
+      // increasing towards upper_ratio_limit.
+      template<class LogPmf>
+      count_cdf_table(LogPmf log_pmf, double mode, int64_t support_min, int64_t support_max,
+        double upper_ratio_limit = 0.0)
+      {
+        if (!(mode < 0x1p62)) {
+          return; // too large, leave the table empty
+        }
+        const int64_t mode_value = std::clamp(static_cast<int64_t>(mode), support_min, support_max);
+        // Bound on the neglected tails, relative to the probability of the
+        // mode.
+        const double negligible = std::ldexp(1.0, -60);
+        const double log_mode = log_pmf(mode_value);
+
+        // Walks from the mode until the remaining tail is negligible. The
+        // tail beyond k is at most pmf(k) r / (1 - r), where r bounds the
+        // ratio of consecutive probabilities further out.
+        auto tail_end = [&](int64_t step, int64_t limit, double ratio_limit) {
+          int64_t k = mode_value;
+          double previous = 1.0;
+          while (k != limit) {
+            const double relative = std::exp(log_pmf(k + step) - log_mode);
+            const double ratio = std::max(relative / previous, ratio_limit);
+            if (relative == 0.0 || (ratio < 1.0 && relative * ratio / (1.0 - ratio) < negligible)) {
+              break;
+            }
+            k += step;
+            previous = relative;
+            if (static_cast<std::size_t>(std::abs(k - mode_value)) >= max_entries) {
+              break;
+            }
+          }
+          return k;
+          };
+        m_first = tail_end(-1, support_min, 0.0);
+        const int64_t last = tail_end(1, support_max, upper_ratio_limit);
+        if (static_cast<uint64_t>(last - m_first) >= max_entries) {
+          return; // too large, leave the table empty
+        }
+
+        const std::size_t size = static_cast<std::size_t>(last - m_first) + 1;
+        m_cdf.resize(size);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < size; ++i) {
+          sum += std::exp(log_pmf(m_first + static_cast<int64_t>(i)) - log_mode);
+          m_cdf[i] = sum;
+        }
+        for (double& c : m_cdf) {
+          c /= sum;
+        }
+        m_cdf.back() = 1.0; // the neglected tails are assigned to the ends
+
+        // m_guide[g] is the first entry with m_cdf > g / size
+        m_guide.resize(size);
+        std::size_t i = 0;
+        for (std::size_t g = 0; g < size; ++g) {
+          const double u = static_cast<double>(g) / static_cast<double>(size);
+          while (m_cdf[i] <= u) ++i;
+          m_guide[g] = static_cast<uint32_t>(i);
+        }
+      }
+
+      bool empty() const
+      {
+        return m_cdf.empty();
+      }
+
+      template<class Generator, typename TargetGdalType>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        uint64_t bits[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_bits(rng, bits, bits + n);
+          fill_from_bits(bits, first, n);
+          first += n;
+        }
+      }
+
+      // Fills out[0, n) taking a word of bits per value.
+      template<typename TargetGdalType>
+      void fill_from_bits(const uint64_t* bits, TargetGdalType* out, std::size_t n) const
+      {
+        const double guide_scale = static_cast<double>(m_guide.size());
+        for (std::size_t j = 0; j < n; ++j) {
+          const double u = unit_interval(bits[j]);
+          uint32_t i = m_guide[static_cast<std::size_t>(u * guide_scale)];
+          while (m_cdf[i] <= u) ++i;
+          out[j] = static_cast<TargetGdalType>(m_first + i);
+        }
+      }
+
+    private:
+      int64_t m_first = 0;
+      std::vector<double> m_cdf;
+      std::vector<uint32_t> m_guide;
+    };
+
+    // k * log(p), taking 0 * log(0) as 0.
+    inline double times_log(double k, double p)
+    {
+      return k == 0.0 ? 0.0 : k * std::log(p);
+    }
+
+    // k * log(1 - p), taking 0 * log(0) as 0.
+    inline double times_log1m(double k, double p)
+    {
+      return k == 0.0 ? 0.0 : k * std::log1p(-p);
+    }
+
+    // Common part of the samplers below: uses the table, or the standard
+    // library distribution if the table is empty.
+    template<class Distribution, typename TargetGdalType>
+    class count_block_sampler
+    {
+    public:
+      count_block_sampler(const Distribution& distribution, count_cdf_table table)
+        : m_fallback(distribution)
+        , m_table(std::move(table))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        if (m_table.empty()) {
+          m_fallback.fill(rng, first, last);
+        }
+        else {
+          m_table.fill(rng, first, last);
+        }
+      }
+
+      template<class EngineOf>
+      void fill_streams(const uint64_t* first_draws, EngineOf engine_of, TargetGdalType* out, std::size_t n) const
+      {
+        if (m_table.empty()) {
+          for (std::size_t i = 0; i < n; ++i) {
+            auto rng = engine_of(i);
+            m_fallback.fill(rng, out + i, out + i + 1);
+          }
+        }
+        else {
+          m_table.fill_from_bits(first_draws, out, n);
+        }
+      }
+
+      const Distribution& distribution() const
+      {
+        return m_fallback.distribution();
+      }
+
+    private:
+      distribution_block_sampler<Distribution, TargetGdalType> m_fallback;
+      count_cdf_table m_table;
+    };
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::poisson_distribution<DistributionType>, TargetGdalType>
+      : public count_block_sampler<std::poisson_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::poisson_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : count_block_sampler<distribution_type, TargetGdalType>(distribution, make_table(distribution))
+      {
+      }
+
+    private:
+      static count_cdf_table make_table(const distribution_type& distribution)
+      {
+        const double mean = distribution.mean();
+        auto log_pmf = [mean](int64_t k) {
+          return times_log(static_cast<double>(k), mean) - mean - std::lgamma(k + 1.0);
+          };
+        return count_cdf_table(log_pmf, std::floor(mean), 0, static_cast<int64_t>(distribution.max()));
+      }
+    };
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::binomial_distribution<DistributionType>, TargetGdalType>
+      : public count_block_sampler<std::binomial_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::binomial_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : count_block_sampler<distribution_type, TargetGdalType>(distribution, make_table(distribution))
+      {
+      }
+
+    private:
+      static count_cdf_table make_table(const distribution_type& distribution)
+      {
+        const double t = static_cast<double>(distribution.t());
+        const double p = distribution.p();
+        auto log_pmf = [t, p](int64_t k) {
+          const double successes = static_cast<double>(k);
+          return std::lgamma(t + 1.0) - std::lgamma(successes + 1.0) - std::lgamma(t - successes + 1.0)
+            + times_log(successes, p) + times_log1m(t - successes, p);
+          };
+        return count_cdf_table(log_pmf, std::floor((t + 1.0) * p), 0, static_cast<int64_t>(distribution.t()));
+      }
+    };
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::geometric_distribution<DistributionType>, TargetGdalType>
+      : public count_block_sampler<std::geometric_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::geometric_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : count_block_sampler<distribution_type, TargetGdalType>(distribution, make_table(distribution))
+      {
+      }
+
+    private:
+      static count_cdf_table make_table(const distribution_type& distribution)
+      {
+        const double p = distribution.p();
+        auto log_pmf = [p](int64_t k) {
+          return std::log(p) + times_log1m(static_cast<double>(k), p);
+          };
+        return count_cdf_table(log_pmf, 0.0, 0, static_cast<int64_t>(distribution.max()), 1.0 - p);
+      }
+    };
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::negative_binomial_distribution<DistributionType>, TargetGdalType>
+      : public count_block_sampler<std::negative_binomial_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::negative_binomial_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : count_block_sampler<distribution_type, TargetGdalType>(distribution, make_table(distribution))
+      {
+      }
+
+    private:
+      static count_cdf_table make_table(const distribution_type& distribution)
+      {
+        const double k = static_cast<double>(distribution.k());
+        const double p = distribution.p();
+        auto log_pmf = [k, p](int64_t n) {
+          const double failures = static_cast<double>(n);
+          return std::lgamma(failures + k) - std::lgamma(failures + 1.0) - std::lgamma(k)
+            + times_log(k, p) + times_log1m(failures, p);
+          };
+        const double mode = k > 1.0 ? std::floor((k - 1.0) * (1.0 - p) / p) : 0.0;
+        return count_cdf_table(log_pmf, mode, 0, static_cast<int64_t>(distribution.max()), 1.0 - p);
+      }
+    };
+
+  } // namespace raster
+} // namespace pronto
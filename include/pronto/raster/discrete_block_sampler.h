@@ -0,0 +1,161 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Batched sampler for std::discrete_distribution using an alias table
+// (Walker 1977, built with the method of Vose 1991), so that the cost per
+// value does not depend on the number of classes.
+//
+// Each value takes a single 64-bit draw: the high 32 bits select a column
+// of the table with Lemire's method (the same kernel as uniform_integer)
+// and the low 32 bits decide between the column and its alias. The table
+// is built once and only read afterwards, so it is shared by all blocks.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/simd_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::discrete_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::discrete_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+      {
+        build_table(distribution.probabilities());
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        uint64_t bits[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_bits(rng, bits, bits + n);
+          lookup(bits, first, n, [&rng](std::size_t) { return rng(); });
+          first += n;
+        }
+      }
+
+      template<class EngineOf>
+      void fill_streams(const uint64_t* first_draws, EngineOf engine_of, TargetGdalType* out, std::size_t n) const
+      {
+        uint64_t bits[sampler_chunk_size];
+        std::copy(first_draws, first_draws + n, bits);
+
+        // Rejected words of a value are redrawn one after the other.
+        std::size_t current = n;
+        auto rng = engine_of(0);
+        lookup(bits, out, n, [&](std::size_t i) {
+          if (i != current) {
+            rng = engine_of(i);
+            rng(); // first_draws[i]
+            current = i;
+          }
+          return rng();
+          });
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      // Fills out[0, n) from a word per value, replacing the words of which
+      // the column is rejected by redraw(i) for value i.
+      template<class Redraw>
+      void lookup(uint64_t* bits, TargetGdalType* out, std::size_t n, Redraw&& redraw) const
+      {
+        const simd_kernels& kernels = get_simd_kernels();
+        const uint32_t columns = static_cast<uint32_t>(m_thresholds.size());
+
+        uint32_t column[sampler_chunk_size];
+        uint32_t values[sampler_chunk_size];
+        if (kernels.bits_to_offsets(bits, column, n, columns, m_column_threshold) > 0) {
+          for (std::size_t i = 0; i < n; ++i) {
+            uint64_t product = (bits[i] >> 32) * columns;
+            while (static_cast<uint32_t>(product) < m_column_threshold) {
+              bits[i] = redraw(i);
+              product = (bits[i] >> 32) * columns;
+            }
+            column[i] = static_cast<uint32_t>(product >> 32);
+          }
+        }
+
+        kernels.alias_lookup(bits, column, values, n, m_thresholds.data(), m_aliases.data());
+        for (std::size_t i = 0; i < n; ++i) {
+          out[i] = static_cast<TargetGdalType>(values[i]);
+        }
+      }
+
+      void build_table(const std::vector<double>& probabilities)
+      {
+        const std::size_t size = probabilities.size();
+        m_thresholds.assign(size, 0xFFFFFFFFu);
+        m_aliases.resize(size);
+        for (std::size_t i = 0; i < size; ++i) {
+          m_aliases[i] = static_cast<uint32_t>(i);
+        }
+        const uint32_t columns = static_cast<uint32_t>(size);
+        m_column_threshold = static_cast<uint32_t>(0u - columns) % columns;
+
+        // Scale so that the average column holds exactly one unit.
+        std::vector<double> scaled(size);
+        std::vector<uint32_t> small;
+        std::vector<uint32_t> large;
+        for (std::size_t i = 0; i < size; ++i) {
+          scaled[i] = probabilities[i] * static_cast<double>(size);
+          (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+        }
+
+        // Top up each under-full column with the excess of a full column.
+        while (!small.empty() && !large.empty()) {
+          const uint32_t under = small.back();
+          small.pop_back();
+          const uint32_t over = large.back();
+
+          m_thresholds[under] = to_threshold(scaled[under]);
+          m_aliases[under] = over;
+          scaled[over] -= 1.0 - scaled[under];
+          if (scaled[over] < 1.0) {
+            large.pop_back();
+            small.push_back(over);
+          }
+        }
+        // Whatever remains is full up to rounding error, and keeps the
+        // column itself as its alias.
+      }
+
+      // Probability p in [0, 1] as the 32-bit threshold for the low bits.
+      static uint32_t to_threshold(double p)
+      {
+        const double scaled = std::ldexp(std::max(p, 0.0), 32);
+        return scaled >= 4294967295.0 ? 0xFFFFFFFFu : static_cast<uint32_t>(scaled);
+      }
+
+      distribution_type m_distribution;
+      std::vector<uint32_t> m_thresholds;
+      std::vector<uint32_t> m_aliases;
+      uint32_t m_column_threshold;
+    };
+
+  } // namespace raster
+} // namespace pronto
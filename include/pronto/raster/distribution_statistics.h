@@ -0,0 +1,474 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Exact statistics of the standard library distributions, and of the
+// samplers that draw from them, as a value_distribution of the stored
+// values.
+//
+// distribution_statistics<Distribution> provides the cumulative
+// distribution function cdf(distribution, x), the support [lower, upper],
+// the mean and the variance. The integer distributions evaluate their
+// cumulative distribution function in closed form or by the incomplete
+// gamma and beta functions, so that it is cheap for any parameters.
+
+#pragma once
+
+#include <pronto/raster/continuous_cdf.h>
+#include <pronto/raster/inverse_cdf_sampler.h>
+#include <pronto/raster/value_distribution.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    template<class Distribution>
+    struct distribution_statistics
+    {
+      static constexpr bool available = false;
+    };
+
+    // Continuous distributions use continuous_cdf, the specializations
+    // below add the moments.
+    template<class Distribution>
+    struct continuous_statistics
+    {
+      static constexpr bool available = true;
+      static constexpr bool integer = false;
+      static double lower(const Distribution& d) { return continuous_cdf<Distribution>::lower(d); }
+      static double upper(const Distribution& d) { return continuous_cdf<Distribution>::upper(d); }
+      static double cdf(const Distribution& d, double x) { return continuous_cdf<Distribution>::cdf(d, x); }
+    };
+
+    // Integer distributions on [0, infinity).
+    struct count_statistics
+    {
+      static constexpr bool available = true;
+      static constexpr bool integer = true;
+
+      template<class Distribution>
+      static double lower(const Distribution&)
+      {
+        return 0.0;
+      }
+
+      template<class Distribution>
+      static double upper(const Distribution&)
+      {
+        return std::numeric_limits<double>::infinity();
+      }
+    };
+
+    constexpr double undefined_moment = std::numeric_limits<double>::quiet_NaN();
+
+    template<typename T>
+    struct distribution_statistics<std::uniform_int_distribution<T>>
+    {
+      static constexpr bool available = true;
+      static constexpr bool integer = true;
+      static double lower(const std::uniform_int_distribution<T>& d) { return static_cast<double>(d.a()); }
+      static double upper(const std::uniform_int_distribution<T>& d) { return static_cast<double>(d.b()); }
+      static double cdf(const std::uniform_int_distribution<T>& d, double x)
+      {
+        const double a = lower(d);
+        const double n = upper(d) - a + 1.0;
+        return std::clamp((std::floor(x) - a + 1.0) / n, 0.0, 1.0);
+      }
+      static double mean(const std::uniform_int_distribution<T>& d) { return 0.5 * (lower(d) + upper(d)); }
+      static double variance(const std::uniform_int_distribution<T>& d)
+      {
+        const double n = upper(d) - lower(d) + 1.0;
+        return (n * n - 1.0) / 12.0;
+      }
+    };
+
+    template<>
+    struct distribution_statistics<std::bernoulli_distribution>
+    {
+      static constexpr bool available = true;
+      static constexpr bool integer = true;
+      static double lower(const std::bernoulli_distribution&) { return 0.0; }
+      static double upper(const std::bernoulli_distribution&) { return 1.0; }
+      static double cdf(const std::bernoulli_distribution& d, double x)
+      {
+        return x < 0.0 ? 0.0 : x < 1.0 ? 1.0 - d.p() : 1.0;
+      }
+      static double mean(const std::bernoulli_distribution& d) { return d.p(); }
+      static double variance(const std::bernoulli_distribution& d) { return d.p() * (1.0 - d.p()); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::binomial_distribution<T>>
+    {
+      static constexpr bool available = true;
+      static constexpr bool integer = true;
+      static double lower(const std::binomial_distribution<T>&) { return 0.0; }
+      static double upper(const std::binomial_distribution<T>& d) { return static_cast<double>(d.t()); }
+      static double cdf(const std::binomial_distribution<T>& d, double x)
+      {
+        const double t = upper(d);
+        if (x < 0.0) return 0.0;
+        if (x >= t) return 1.0;
+        const double k = std::floor(x);
+        return regularized_beta(1.0 - d.p(), t - k, k + 1.0);
+      }
+      static double mean(const std::binomial_distribution<T>& d) { return upper(d) * d.p(); }
+      static double variance(const std::binomial_distribution<T>& d) { return upper(d) * d.p() * (1.0 - d.p()); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::negative_binomial_distribution<T>> : count_statistics
+    {
+      static double cdf(const std::negative_binomial_distribution<T>& d, double x)
+      {
+        if (x < 0.0) return 0.0;
+        return regularized_beta(d.p(), static_cast<double>(d.k()), std::floor(x) + 1.0);
+      }
+      static double mean(const std::negative_binomial_distribution<T>& d)
+      {
+        return static_cast<double>(d.k()) * (1.0 - d.p()) / d.p();
+      }
+      static double variance(const std::negative_binomial_distribution<T>& d)
+      {
+        return mean(d) / d.p();
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::geometric_distribution<T>> : count_statistics
+    {
+      static double cdf(const std::geometric_distribution<T>& d, double x)
+      {
+        if (x < 0.0) return 0.0;
+        return -std::expm1((std::floor(x) + 1.0) * std::log1p(-d.p()));
+      }
+      static double mean(const std::geometric_distribution<T>& d) { return (1.0 - d.p()) / d.p(); }
+      static double variance(const std::geometric_distribution<T>& d) { return mean(d) / d.p(); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::poisson_distribution<T>> : count_statistics
+    {
+      static double cdf(const std::poisson_distribution<T>& d, double x)
+      {
+        if (x < 0.0) return 0.0;
+        return 1.0 - regularized_gamma_p(std::floor(x) + 1.0, d.mean());
+      }
+      static double mean(const std::poisson_distribution<T>& d) { return d.mean(); }
+      static double variance(const std::poisson_distribution<T>& d) { return d.mean(); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::discrete_distribution<T>>
+    {
+      static constexpr bool available = true;
+      static constexpr bool integer = true;
+      static double lower(const std::discrete_distribution<T>&) { return 0.0; }
+      static double upper(const std::discrete_distribution<T>& d)
+      {
+        return static_cast<double>(d.probabilities().size()) - 1.0;
+      }
+      static double cdf(const std::discrete_distribution<T>& d, double x)
+      {
+        const std::vector<double> probabilities = d.probabilities();
+        double sum = 0.0;
+        for (std::size_t i = 0; i < probabilities.size() && static_cast<double>(i) <= x; ++i) {
+          sum += probabilities[i];
+        }
+        return std::min(sum, 1.0);
+      }
+      static double mean(const std::discrete_distribution<T>& d)
+      {
+        const std::vector<double> probabilities = d.probabilities();
+        double sum = 0.0;
+        for (std::size_t i = 0; i < probabilities.size(); ++i) {
+          sum += static_cast<double>(i) * probabilities[i];
+        }
+        return sum;
+      }
+      static double variance(const std::discrete_distribution<T>& d)
+      {
+        const std::vector<double> probabilities = d.probabilities();
+        const double m = mean(d);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < probabilities.size(); ++i) {
+          sum += (static_cast<double>(i) - m) * (static_cast<double>(i) - m) * probabilities[i];
+        }
+        return sum;
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::uniform_real_distribution<T>>
+      : continuous_statistics<std::uniform_real_distribution<T>>
+    {
+      static double mean(const std::uniform_real_distribution<T>& d) { return 0.5 * (d.a() + d.b()); }
+      static double variance(const std::uniform_real_distribution<T>& d)
+      {
+        const double width = d.b() - d.a();
+        return width * width / 12.0;
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::normal_distribution<T>>
+      : continuous_statistics<std::normal_distribution<T>>
+    {
+      static double mean(const std::normal_distribution<T>& d) { return d.mean(); }
+      static double variance(const std::normal_distribution<T>& d) { return d.stddev() * d.stddev(); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::lognormal_distribution<T>>
+      : continuous_statistics<std::lognormal_distribution<T>>
+    {
+      static double mean(const std::lognormal_distribution<T>& d) { return std::exp(d.m() + 0.5 * d.s() * d.s()); }
+      static double variance(const std::lognormal_distribution<T>& d)
+      {
+        const double s2 = d.s() * d.s();
+        return std::expm1(s2) * std::exp(2.0 * d.m() + s2);
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::gamma_distribution<T>>
+      : continuous_statistics<std::gamma_distribution<T>>
+    {
+      static double mean(const std::gamma_distribution<T>& d) { return d.alpha() * d.beta(); }
+      static double variance(const std::gamma_distribution<T>& d) { return d.alpha() * d.beta() * d.beta(); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::exponential_distribution<T>>
+      : continuous_statistics<std::exponential_distribution<T>>
+    {
+      static double mean(const std::exponential_distribution<T>& d) { return 1.0 / d.lambda(); }
+      static double variance(const std::exponential_distribution<T>& d) { return 1.0 / (d.lambda() * d.lambda()); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::weibull_distribution<T>>
+      : continuous_statistics<std::weibull_distribution<T>>
+    {
+      static double mean(const std::weibull_distribution<T>& d) { return d.b() * std::tgamma(1.0 + 1.0 / d.a()); }
+      static double variance(const std::weibull_distribution<T>& d)
+      {
+        const double g1 = std::tgamma(1.0 + 1.0 / d.a());
+        return d.b() * d.b() * (std::tgamma(1.0 + 2.0 / d.a()) - g1 * g1);
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::extreme_value_distribution<T>>
+      : continuous_statistics<std::extreme_value_distribution<T>>
+    {
+      static double mean(const std::extreme_value_distribution<T>& d)
+      {
+        const double euler_gamma = 0.57721566490153286061;
+        return d.a() + d.b() * euler_gamma;
+      }
+      static double variance(const std::extreme_value_distribution<T>& d)
+      {
+        const double pi = 3.14159265358979323846;
+        return pi * pi * d.b() * d.b() / 6.0;
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::cauchy_distribution<T>>
+      : continuous_statistics<std::cauchy_distribution<T>>
+    {
+      static double mean(const std::cauchy_distribution<T>&) { return undefined_moment; }
+      static double variance(const std::cauchy_distribution<T>&) { return undefined_moment; }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::chi_squared_distribution<T>>
+      : continuous_statistics<std::chi_squared_distribution<T>>
+    {
+      static double mean(const std::chi_squared_distribution<T>& d) { return d.n(); }
+      static double variance(const std::chi_squared_distribution<T>& d) { return 2.0 * d.n(); }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::student_t_distribution<T>>
+      : continuous_statistics<std::student_t_distribution<T>>
+    {
+      static double mean(const std::student_t_distribution<T>& d) { return d.n() > 1.0 ? 0.0 : undefined_moment; }
+      static double variance(const std::student_t_distribution<T>& d)
+      {
+        if (d.n() > 2.0) return d.n() / (d.n() - 2.0);
+        return d.n() > 1.0 ? std::numeric_limits<double>::infinity() : undefined_moment;
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::fisher_f_distribution<T>>
+      : continuous_statistics<std::fisher_f_distribution<T>>
+    {
+      static double mean(const std::fisher_f_distribution<T>& d)
+      {
+        return d.n() > 2.0 ? d.n() / (d.n() - 2.0) : undefined_moment;
+      }
+      static double variance(const std::fisher_f_distribution<T>& d)
+      {
+        const double m = d.m();
+        const double n = d.n();
+        if (n > 4.0) return 2.0 * n * n * (m + n - 2.0) / (m * (n - 2.0) * (n - 2.0) * (n - 4.0));
+        return n > 2.0 ? std::numeric_limits<double>::infinity() : undefined_moment;
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::piecewise_constant_distribution<T>>
+      : continuous_statistics<std::piecewise_constant_distribution<T>>
+    {
+      static double mean(const std::piecewise_constant_distribution<T>& d)
+      {
+        const std::vector<T> intervals = d.intervals();
+        const std::vector<double> densities = d.densities();
+        double sum = 0.0;
+        for (std::size_t i = 0; i < densities.size(); ++i) {
+          const double u = intervals[i];
+          const double v = intervals[i + 1];
+          sum += densities[i] * (v * v - u * u) / 2.0;
+        }
+        return sum;
+      }
+      static double variance(const std::piecewise_constant_distribution<T>& d)
+      {
+        const std::vector<T> intervals = d.intervals();
+        const std::vector<double> densities = d.densities();
+        const double m = mean(d);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < densities.size(); ++i) {
+          const double u = intervals[i] - m;
+          const double v = intervals[i + 1] - m;
+          sum += densities[i] * (v * v * v - u * u * u) / 3.0;
+        }
+        return sum;
+      }
+    };
+
+    template<typename T>
+    struct distribution_statistics<std::piecewise_linear_distribution<T>>
+      : continuous_statistics<std::piecewise_linear_distribution<T>>
+    {
+      static double mean(const std::piecewise_linear_distribution<T>& d)
+      {
+        return central_moment(d, 0.0, 1);
+      }
+      static double variance(const std::piecewise_linear_distribution<T>& d)
+      {
+        return central_moment(d, mean(d), 2);
+      }
+
+    private:
+      // Integral of (x - center)^power times the density, which is linear on
+      // each interval, power being 1 or 2.
+      static double central_moment(const std::piecewise_linear_distribution<T>& d, double center, int power)
+      {
+        const std::vector<T> intervals = d.intervals();
+        const std::vector<double> densities = d.densities();
+        double sum = 0.0;
+        for (std::size_t i = 0; i + 1 < intervals.size(); ++i) {
+          const double u = intervals[i] - center;
+          const double v = intervals[i + 1] - center;
+          const double fu = densities[i];
+          const double fv = densities[i + 1];
+          if (power == 1) {
+            sum += (v - u) / 6.0 * (fu * (2.0 * u + v) + fv * (u + 2.0 * v));
+          }
+          else {
+            sum += (v - u) / 12.0 * (fu * (3.0 * u * u + 2.0 * u * v + v * v) + fv * (u * u + 2.0 * u * v + 3.0 * v * v));
+          }
+        }
+        return sum;
+      }
+    };
+
+    // Distribution of the values of a sampler, converted to TargetGdalType.
+    // Integer values that do not fit in the target type wrap around when
+    // converted; the distribution is then unavailable, unless they are
+    // negligibly rare.
+    template<typename TargetGdalType, class Sampler>
+    value_distribution make_value_distribution(const Sampler& sampler)
+    {
+      using distribution_type = std::decay_t<decltype(sampler.distribution())>;
+      using statistics = distribution_statistics<distribution_type>;
+      if constexpr (!statistics::available) {
+        return value_distribution();
+      }
+      else {
+        const distribution_type d = sampler.distribution();
+        double lower = statistics::lower(d);
+        double upper = statistics::upper(d);
+        if constexpr (std::numeric_limits<TargetGdalType>::is_integer) {
+          const double lowest = static_cast<double>(std::numeric_limits<TargetGdalType>::lowest());
+          const double highest = static_cast<double>(std::numeric_limits<TargetGdalType>::max());
+          const double outside = statistics::cdf(d, lowest - 1.0) + (1.0 - statistics::cdf(d, highest));
+          if (outside > std::ldexp(1.0, -40)) {
+            return value_distribution();
+          }
+        }
+        else {
+          // Finite bounds are rounded as the values are.
+          if (std::isfinite(lower)) lower = static_cast<TargetGdalType>(lower);
+          if (std::isfinite(upper)) upper = static_cast<TargetGdalType>(upper);
+        }
+        auto cdf = [d](double x) { return statistics::cdf(d, x); };
+        return value_distribution(cdf, lower, upper, statistics::mean(d), statistics::variance(d),
+          statistics::integer);
+      }
+    }
+
+    // The inverse_cdf_sampler draws from its table rather than from the
+    // distribution: the probability is spread evenly over the intervals of
+    // the table, and linearly within each interval, other than the first 
+    // and last interval that follow the distribution.
+    template<typename TargetGdalType, class Distribution>
+    value_distribution make_value_distribution(const inverse_cdf_sampler<Distribution, TargetGdalType>& sampler)
+    {
+      const std::vector<double>& table = sampler.table();
+      const double intervals = static_cast<double>(table.size() - 1);
+      auto cdf = [sampler](double x) { return sampler.cdf(x); };
+
+      double first_mean, first_mean_square, last_mean, last_mean_square;
+      sampler.outer_interval_moments(false, first_mean, first_mean_square);
+      sampler.outer_interval_moments(true, last_mean, last_mean_square);
+
+      double mean = first_mean + last_mean;
+      for (std::size_t i = 1; i + 2 < table.size(); ++i) {
+        mean += 0.5 * (table[i] + table[i + 1]);
+      }
+      mean /= intervals;
+      double variance = first_mean_square - 2.0 * mean * first_mean + mean * mean
+        + last_mean_square - 2.0 * mean * last_mean + mean * mean;
+      for (std::size_t i = 1; i + 2 < table.size(); ++i) {
+        const double u = table[i] - mean;
+        const double v = table[i + 1] - mean;
+        variance += (u * u + u * v + v * v) / 3.0;
+      }
+      variance /= intervals;
+
+      // Unbounded sides remain unbounded, although the table cuts them.
+      const double lower = std::isfinite(sampler.lower()) ? static_cast<double>(static_cast<TargetGdalType>(table.front()))
+        : -std::numeric_limits<double>::infinity();
+      const double upper = std::isfinite(sampler.upper()) ? static_cast<double>(static_cast<TargetGdalType>(table.back()))
+        : std::numeric_limits<double>::infinity();
+      return value_distribution(cdf, lower, upper, mean, variance, false);
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,69 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Mixed radix fast Fourier transform for sizes whose only prime factors are
+// 2, 3 and 5, so that transforms can be padded to a size close to the data
+// rather than to the next power of two.
+//
+// The forward transform is X[k] = sum_j x[j] exp(-2 pi i j k / n), the
+// inverse transform uses exp(+2 pi i j k / n) and is not scaled.
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    class fft_plan
+    {
+    public:
+      // n must be a product of 2, 3 and 5, see next_size.
+      explicit fft_plan(std::size_t n);
+
+      std::size_t size() const;
+
+      // Transforms the n values x[k * stride] in place. scratch must hold
+      // 2 * n values.
+      void forward(std::complex<double>* x, std::ptrdiff_t stride, std::complex<double>* scratch) const;
+      void inverse(std::complex<double>* x, std::ptrdiff_t stride, std::complex<double>* scratch) const;
+
+      // The smallest size of at least n with no prime factors above 5.
+      static std::size_t next_size(std::size_t n);
+
+    private:
+      void transform(const std::complex<double>* in, std::ptrdiff_t stride, std::complex<double>* out,
+        std::size_t n, std::size_t factor_index) const;
+
+      std::size_t m_size;
+      std::vector<std::size_t> m_factors;
+      std::vector<std::complex<double>> m_twiddles; // exp(-2 pi i k / n)
+    };
+
+    // Two dimensional transform of a rows x cols array with rows of cols
+    // values.
+    class fft_plan_2d
+    {
+    public:
+      fft_plan_2d(std::size_t rows, std::size_t cols);
+
+      std::size_t rows() const;
+      std::size_t cols() const;
+
+      void forward(std::complex<double>* x) const;
+      void inverse(std::complex<double>* x) const;
+
+    private:
+      fft_plan m_rows; // transforms along the columns, of length rows
+      fft_plan m_cols; // transforms along the rows, of length cols
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,198 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Class for filling GDAL raster blocks with the values of a spatial_field.
+// The values are converted to the data type of the band, rounding to the
+// nearest integer and clamping to the range of integer types.
+
+#pragma once
+
+#include <pronto/raster/block_generator_interface.h>
+#include <pronto/raster/spatial_field.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    template<typename TargetGdalType>
+    class field_block_generator : public block_generator_interface
+    {
+    public:
+      field_block_generator(std::unique_ptr<spatial_field> field, int rows, int cols,
+        int block_rows, int block_cols)
+        : m_field(std::move(field))
+        , m_rows(rows)
+        , m_cols(cols)
+        , m_block_rows(block_rows)
+        , m_block_cols(block_cols)
+      {
+        // Rounding changes the distribution of real values.
+        const value_distribution& values = m_field->get_value_distribution();
+        if (!std::numeric_limits<TargetGdalType>::is_integer || values.integer()) {
+          m_values = values;
+        }
+      }
+
+      // Blocks on the right and bottom edge of the raster only hold the 
+      // values inside the raster, the remainder is set to zero.
+      void fill_block(int major_row, int major_col, void* block, size_t num_elements_in_block) override
+      {
+        TargetGdalType* block_begin = static_cast<TargetGdalType*>(block);
+        const int first_row = major_row * m_block_rows;
+        const int first_col = major_col * m_block_cols;
+        const int valid_rows = std::min(m_block_rows, m_rows - first_row);
+        const int valid_cols = std::min(m_block_cols, m_cols - first_col);
+        if (valid_rows < m_block_rows || valid_cols < m_block_cols) {
+          std::fill(block_begin, block_begin + num_elements_in_block, TargetGdalType{});
+        }
+
+        std::vector<double> values(static_cast<size_t>(m_block_rows) * m_block_cols);
+        m_field->generate(first_row, first_col, m_block_rows, m_block_cols, values.data(), m_block_cols);
+        convert(values.data(), m_block_cols, valid_rows, valid_cols, block,
+          sizeof(TargetGdalType), m_block_cols * sizeof(TargetGdalType));
+      }
+
+      // Fields that are not pixel addressable generate the blocks 
+      // overlapping the window in full, so that the values do not depend on
+      // the window.
+      void fill_window(int first_row, int first_col, int rows, int cols, void* buffer,
+        std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) override
+      {
+        if (rows <= 0 || cols <= 0) {
+          return;
+        }
+        std::vector<double> values;
+        if (m_field->pixel_addressable()) {
+          values.resize(static_cast<size_t>(rows) * cols);
+          m_field->generate(first_row, first_col, rows, cols, values.data(), cols);
+          convert(values.data(), cols, rows, cols, buffer, pixel_space, line_space);
+          return;
+        }
+
+        values.resize(static_cast<size_t>(m_block_rows) * m_block_cols);
+        const int last_row = first_row + rows;
+        const int last_col = first_col + cols;
+        for (int major_row = first_row / m_block_rows; major_row * m_block_rows < last_row; ++major_row) {
+          const int block_row = major_row * m_block_rows;
+          const int row_begin = std::max(first_row, block_row);
+          const int row_end = std::min(last_row, block_row + m_block_rows);
+          for (int major_col = first_col / m_block_cols; major_col * m_block_cols < last_col; ++major_col) {
+            const int block_col = major_col * m_block_cols;
+            const int col_begin = std::max(first_col, block_col);
+            const int col_end = std::min(last_col, block_col + m_block_cols);
+            m_field->generate(block_row, block_col, m_block_rows, m_block_cols, values.data(), m_block_cols);
+            char* target = static_cast<char*>(buffer)
+              + (row_begin - first_row) * line_space + (col_begin - first_col) * pixel_space;
+            convert(values.data() + static_cast<size_t>(row_begin - block_row) * m_block_cols + (col_begin - block_col),
+              m_block_cols, row_end - row_begin, col_end - col_begin, target, pixel_space, line_space);
+          }
+        }
+      }
+
+      bool pixel_addressable() const override
+      {
+        return m_field->pixel_addressable();
+      }
+
+      void fill_sampled(const int* rows, int num_rows, const int* cols, int num_cols,
+        void* buffer, std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) override
+      {
+        if (!m_field->pixel_addressable()) {
+          return;
+        }
+        for (int r = 0; r < num_rows; ++r) {
+          char* row_begin = static_cast<char*>(buffer) + r * line_space;
+          for (int c = 0; c < num_cols; ++c) {
+            double value;
+            m_field->generate(rows[r], cols[c], 1, 1, &value, 1);
+            convert(&value, 1, 1, 1, row_begin + c * pixel_space, pixel_space, line_space);
+          }
+        }
+      }
+
+      const value_distribution& get_value_distribution() const override
+      {
+        return m_values;
+      }
+
+      double get_min() const override
+      {
+        if (m_values.available()) {
+          return m_values.expected_min(static_cast<uint64_t>(m_rows) * m_cols);
+        }
+        return static_cast<double>(std::numeric_limits<TargetGdalType>::lowest());
+      }
+
+      double get_max() const override
+      {
+        if (m_values.available()) {
+          return m_values.expected_max(static_cast<uint64_t>(m_rows) * m_cols);
+        }
+        return static_cast<double>(std::numeric_limits<TargetGdalType>::max());
+      }
+
+      double get_mean() const override
+      {
+        return m_values.has_moments() ? m_values.mean() : std::numeric_limits<double>::quiet_NaN();
+      }
+
+      double get_std_dev() const override
+      {
+        return m_values.has_moments() ? m_values.std_dev() : std::numeric_limits<double>::quiet_NaN();
+      }
+
+    private:
+      // Converts rows x cols values, with rows line_stride values apart, 
+      // into the buffer.
+      static void convert(const double* values, std::ptrdiff_t line_stride, int rows, int cols,
+        void* buffer, std::ptrdiff_t pixel_space, std::ptrdiff_t line_space)
+      {
+        for (int r = 0; r < rows; ++r) {
+          const double* source = values + r * line_stride;
+          char* target = static_cast<char*>(buffer) + r * line_space;
+          for (int c = 0; c < cols; ++c) {
+            const TargetGdalType value = to_target(source[c]);
+            std::memcpy(target + c * pixel_space, &value, sizeof(TargetGdalType));
+          }
+        }
+      }
+
+      static TargetGdalType to_target(double value)
+      {
+        if constexpr (std::numeric_limits<TargetGdalType>::is_integer) {
+          const double lowest = static_cast<double>(std::numeric_limits<TargetGdalType>::lowest());
+          const double highest = static_cast<double>(std::numeric_limits<TargetGdalType>::max());
+          const double rounded = std::nearbyint(value);
+          if (!(rounded > lowest)) return std::numeric_limits<TargetGdalType>::lowest(); // also NaN
+          if (rounded >= highest) return std::numeric_limits<TargetGdalType>::max();
+          return static_cast<TargetGdalType>(rounded);
+        }
+        else {
+          return static_cast<TargetGdalType>(value);
+        }
+      }
+
+      std::unique_ptr<spatial_field> m_field;
+      int m_rows;
+      int m_cols;
+      int m_block_rows;
+      int m_block_cols;
+      value_distribution m_values;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,271 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Batched samplers for the gamma family: std::gamma_distribution,
+// std::chi_squared_distribution, std::student_t_distribution and
+// std::fisher_f_distribution.
+//
+// All are built on standard_gamma_sampler, which implements the method of
+// Marsaglia and Tsang (2000) for chunks of values: the normal variates come
+// from the batched ziggurat, the cheap squeeze test is evaluated for the
+// whole chunk, and the accepted candidates are compacted into the output.
+// Attempts are repeated for the remaining (few percent) of the values.
+//
+// The scratch space of standard_gamma_sampler is held by the caller, so that
+// the composite samplers for student_t and fisher_f share one set of chunk
+// buffers between their variates rather than stacking a set per call.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/ziggurat_normal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace pronto {
+  namespace raster {
+
+    // Chunk buffers used by standard_gamma_sampler::fill.
+    struct gamma_scratch
+    {
+      double z[sampler_chunk_size];
+      uint64_t bits[sampler_chunk_size];
+    };
+
+    class standard_gamma_sampler
+    {
+    public:
+      // Gamma distribution with shape alpha and unit scale.
+      explicit standard_gamma_sampler(double alpha)
+        : m_boost(alpha < 1.0)
+        , m_inverse_alpha(1.0 / alpha)
+        , m_d((alpha < 1.0 ? alpha + 1.0 : alpha) - 1.0 / 3.0)
+        , m_c(1.0 / std::sqrt(9.0 * m_d))
+      {
+      }
+
+      // Fills out[0, n) with gamma variates, n <= sampler_chunk_size.
+      template<class Generator>
+      void fill(Generator& rng, double* out, std::size_t n, gamma_scratch& scratch) const
+      {
+        double* z = scratch.z;
+        uint64_t* bits = scratch.bits;
+
+        std::size_t filled = 0;
+        while (filled < n) {
+          const std::size_t attempts = n - filled;
+          fill_standard_normal(rng, z, attempts, bits);
+          fill_bits(rng, bits, bits + attempts);
+
+          // The candidates are held in the unfilled part of out; accepted
+          // values are compacted in front of them, never past the candidate
+          // that is being tested.
+          double* v = out + filled;
+
+          for (std::size_t i = 0; i < attempts; ++i) {
+            const double t = 1.0 + m_c * z[i];
+            v[i] = t * t * t;
+          }
+
+          for (std::size_t i = 0; i < attempts; ++i) {
+            if (v[i] <= 0.0) continue;
+            const double u = positive_unit_interval(bits[i]);
+            const double z2 = z[i] * z[i];
+            if (u < 1.0 - 0.0331 * z2 * z2
+              || std::log(u) < 0.5 * z2 + m_d * (1.0 - v[i] + std::log(v[i]))) {
+              out[filled++] = m_d * v[i];
+            }
+          }
+        }
+
+        if (m_boost) {
+          // Gamma(alpha) = Gamma(alpha + 1) * U^(1 / alpha)
+          fill_bits(rng, bits, bits + n);
+          for (std::size_t i = 0; i < n; ++i) {
+            out[i] *= std::exp(std::log(positive_unit_interval(bits[i])) * m_inverse_alpha);
+          }
+        }
+      }
+
+    private:
+      bool m_boost;
+      double m_inverse_alpha;
+      double m_d;
+      double m_c;
+    };
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::gamma_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::gamma_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_gamma(static_cast<double>(distribution.alpha()))
+        , m_beta(static_cast<double>(distribution.beta()))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        gamma_scratch scratch;
+        double g[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          m_gamma.fill(rng, g, n, scratch);
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(m_beta * g[i]);
+          }
+          first += n;
+        }
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      distribution_type m_distribution;
+      standard_gamma_sampler m_gamma;
+      double m_beta;
+    };
+
+    // Chi-squared(n) = Gamma(n / 2, 2)
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::chi_squared_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::chi_squared_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_gamma(0.5 * static_cast<double>(distribution.n()))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        gamma_scratch scratch;
+        double g[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          m_gamma.fill(rng, g, n, scratch);
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(2.0 * g[i]);
+          }
+          first += n;
+        }
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      distribution_type m_distribution;
+      standard_gamma_sampler m_gamma;
+    };
+
+    // Student-t(n) = Z / sqrt(Chi-squared(n) / n) = Z * sqrt(n / (2 Gamma(n / 2)))
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::student_t_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::student_t_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_gamma(0.5 * static_cast<double>(distribution.n()))
+        , m_half_n(0.5 * static_cast<double>(distribution.n()))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        gamma_scratch scratch;
+        double z[sampler_chunk_size];
+        double g[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_standard_normal(rng, z, n, scratch.bits);
+          m_gamma.fill(rng, g, n, scratch);
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(z[i] * std::sqrt(m_half_n / g[i]));
+          }
+          first += n;
+        }
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      distribution_type m_distribution;
+      standard_gamma_sampler m_gamma;
+      double m_half_n;
+    };
+
+    // Fisher-F(m, n) = (Chi-squared(m) / m) / (Chi-squared(n) / n)
+    //                = (Gamma(m / 2) / Gamma(n / 2)) * (n / m)
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::fisher_f_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::fisher_f_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_numerator(0.5 * static_cast<double>(distribution.m()))
+        , m_denominator(0.5 * static_cast<double>(distribution.n()))
+        , m_ratio(static_cast<double>(distribution.n()) / static_cast<double>(distribution.m()))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        gamma_scratch scratch;
+        double numerator[sampler_chunk_size];
+        double denominator[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          m_numerator.fill(rng, numerator, n, scratch);
+          m_denominator.fill(rng, denominator, n, scratch);
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(m_ratio * numerator[i] / denominator[i]);
+          }
+          first += n;
+        }
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      distribution_type m_distribution;
+      standard_gamma_sampler m_numerator;
+      standard_gamma_sampler m_denominator;
+      double m_ratio;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,80 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Stationary Gaussian random field with an isotropic covariance, generated
+// as white noise convolved with a kernel whose Fourier transform is the 
+// square root of the spectral density of the covariance. 
+//
+// The kernel is found by circulant embedding of the covariance on a grid
+// that is large compared to the correlation length, and truncated where all
+// but 1e-4 of its squared mass is retained. It is then scaled such that the
+// variance is exact. The convolution of a block needs the white noise of the
+// block and a halo of the radius of the kernel, so every block is generated
+// on its own by a fast Fourier transform of an overlapping tile. The white 
+// noise is a function of the seed, the stream and the position of the cell,
+// so that the field does not depend on the block size, other than by 
+// rounding.
+
+#pragma once
+
+#include <pronto/raster/fft.h>
+#include <pronto/raster/spatial_field.h>
+#include <pronto/raster/value_distribution.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    enum class covariance_model {
+      exponential, // exp(-h / length)
+      gaussian,    // exp(-(h / length)^2)
+      matern       // Matern with smoothness nu, exponential for nu = 0.5
+    };
+
+    class gaussian_random_field : public spatial_field
+    {
+    public:
+      // The correlation_length is in cells, nu is only used by matern.
+      gaussian_random_field(uint64_t seed, uint64_t stream, int block_rows, int block_cols,
+        double mean, double stddev, covariance_model covariance, double correlation_length, double nu);
+
+      void generate(int first_row, int first_col, int rows, int cols, double* values,
+        std::ptrdiff_t line_stride) const override;
+
+      bool pixel_addressable() const override;
+
+      const value_distribution& get_value_distribution() const override;
+
+      // Radius of the kernel in cells, i.e. the halo of a block.
+      int kernel_radius() const;
+
+      // The largest correlation length, scaled by the decay of the 
+      // covariance, for which the kernel can be found. It can also not 
+      // exceed the block rows and columns.
+      static constexpr double max_correlation_length = 128.0;
+
+    private:
+      // Standard normal value of a cell.
+      double noise(int row, int col) const;
+
+      uint64_t m_key;
+      double m_mean;
+      double m_stddev;
+      int m_radius;
+      int m_block_rows;
+      int m_block_cols;
+      fft_plan_2d m_tile_plan;
+      std::vector<double> m_tile_spectrum; // transform of the kernel, scaled by the inverse transform
+      value_distribution m_values;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,233 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Sampler for continuous distributions that tabulates the inverse of the
+// cumulative distribution function when the dataset is opened. Each value
+// then takes one uniform draw and a linear interpolation in the table,
+// which the bits_to_table kernel evaluates for whole chunks.
+//
+// The table can be restricted to a [min, max] interval, which truncates the
+// distribution at no extra cost per value. Interpolation would spread the 
+// tails evenly over the outermost table intervals, so the draws that fall
+// in those, 2 in 16384, are instead found by inverting the cumulative 
+// distribution function. Unbounded tails are cut at a probability of 2^-40,
+// the mass beyond that is given the value at the cut.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/continuous_cdf.h>
+#include <pronto/raster/simd_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    template<class Distribution, typename TargetGdalType>
+    class inverse_cdf_sampler
+    {
+    public:
+      // Number of intervals in the table.
+      static constexpr int table_bits = 14;
+      static constexpr uint32_t table_intervals = 1u << table_bits;
+
+      // Samples from the distribution truncated to [min, max], use infinite
+      // bounds for no truncation.
+      inverse_cdf_sampler(const Distribution& distribution, double min, double max)
+        : m_distribution(distribution)
+      {
+        build_table(min, max);
+        m_lowest = static_cast<TargetGdalType>(m_table.front());
+        m_highest = static_cast<TargetGdalType>(m_table.back());
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        const simd_kernels& kernels = get_simd_kernels();
+        uint64_t bits[sampler_chunk_size];
+        double values[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_bits(rng, bits, bits + n);
+          kernels.bits_to_table(bits, values, n, m_table.data(), table_intervals);
+          invert_outer_intervals(bits, values, n);
+          for (std::size_t i = 0; i < n; ++i) {
+            // Clamping guards against rounding when narrowing to the target
+            // type.
+            first[i] = std::clamp(static_cast<TargetGdalType>(values[i]), m_lowest, m_highest);
+          }
+          first += n;
+        }
+      }
+
+      template<class EngineOf>
+      void fill_streams(const uint64_t* first_draws, EngineOf, TargetGdalType* out, std::size_t n) const
+      {
+        double values[sampler_chunk_size];
+        get_simd_kernels().bits_to_table(first_draws, values, n, m_table.data(), table_intervals);
+        invert_outer_intervals(first_draws, values, n);
+        for (std::size_t i = 0; i < n; ++i) {
+          out[i] = std::clamp(static_cast<TargetGdalType>(values[i]), m_lowest, m_highest);
+        }
+      }
+
+      const Distribution& distribution() const
+      {
+        return m_distribution;
+      }
+
+      const std::vector<double>& table() const
+      {
+        return m_table;
+      }
+
+      // Bounds of the sampled interval, infinite where the distribution is
+      // neither bounded nor truncated.
+      double lower() const
+      {
+        return m_lower;
+      }
+
+      double upper() const
+      {
+        return m_upper;
+      }
+
+      // Probability of a sampled value <= x.
+      double cdf(double x) const
+      {
+        using cdf_type = continuous_cdf<Distribution>;
+        if (x < m_table.front()) return 0.0;
+        if (x >= m_table.back()) return 1.0;
+        const double mass = m_p_high - m_p_low;
+        if (x < m_table[1]) {
+          const double below = cdf_type::cdf(m_distribution, x) - m_p_low;
+          return below < m_low_cut ? 0.0 : std::min(below / mass, 1.0 / table_intervals);
+        }
+        if (x >= m_table[table_intervals - 1]) {
+          const double above = m_p_high - cdf_type::cdf(m_distribution, x);
+          return above < m_high_cut ? 1.0 : std::max(1.0 - above / mass, 1.0 - 1.0 / table_intervals);
+        }
+        const std::size_t i = std::upper_bound(m_table.begin(), m_table.end(), x) - m_table.begin() - 1;
+        return (static_cast<double>(i) + (x - m_table[i]) / (m_table[i + 1] - m_table[i])) / table_intervals;
+      }
+
+      // Mean and mean square of the values sampled in the first (upper is
+      // false) or last table interval. The values are integrated over the 
+      // logarithm of the distance to the outer end of the interval, with
+      // eight points per halving, down to the resolution of the draws.
+      void outer_interval_moments(bool upper, double& mean, double& mean_square) const
+      {
+        const int points = 8 * fraction_bits;
+        const double remainder = std::ldexp(1.0, -fraction_bits);
+        double x = outer_value(upper, remainder);
+        mean = remainder * x;
+        mean_square = remainder * x * x;
+        double previous_x = x;
+        double previous_g = remainder;
+        for (int j = points - 1; j >= 0; --j) {
+          const double g = std::exp2(-j / 8.0);
+          x = outer_value(upper, g);
+          mean += 0.5 * (g - previous_g) * (x + previous_x);
+          mean_square += 0.5 * (g - previous_g) * (x * x + previous_x * previous_x);
+          previous_x = x;
+          previous_g = g;
+        }
+      }
+
+    private:
+      // Bits of the draw that give the position within a table interval.
+      static constexpr int fraction_bits = 52 - table_bits;
+
+      // Value in the first or last interval, at a distance g from the outer
+      // end of it, as a share of the interval.
+      double outer_value(bool upper, double g) const
+      {
+        const double interval_mass = (m_p_high - m_p_low) / table_intervals;
+        if (upper) {
+          const double p = m_p_high - std::max(g * interval_mass, m_high_cut);
+          return std::clamp(inverse_cdf(m_distribution, p, m_table[table_intervals - 1], m_table.back()),
+            m_table[table_intervals - 1], m_table.back());
+        }
+        const double p = m_p_low + std::max(g * interval_mass, m_low_cut);
+        return std::clamp(inverse_cdf(m_distribution, p, m_table.front(), m_table[1]),
+          m_table.front(), m_table[1]);
+      }
+
+      // Replaces the interpolated values of the draws in the first and last
+      // interval, with the position in the interval taken as bits_to_table
+      // does.
+      void invert_outer_intervals(const uint64_t* bits, double* values, std::size_t n) const
+      {
+        const uint64_t fraction_mask = (uint64_t{ 1 } << fraction_bits) - 1;
+        const double fraction_scale = std::ldexp(1.0, -fraction_bits);
+        for (std::size_t i = 0; i < n; ++i) {
+          const uint64_t mantissa = bits[i] >> 12;
+          const uint64_t k = mantissa >> fraction_bits;
+          if (k == 0 || k == table_intervals - 1) {
+            const double fraction = static_cast<double>(mantissa & fraction_mask) * fraction_scale;
+            values[i] = k == 0 ? outer_value(false, fraction) : outer_value(true, 1.0 - fraction);
+          }
+        }
+      }
+
+      void build_table(double min, double max)
+      {
+        using cdf_type = continuous_cdf<Distribution>;
+        const double tail = std::ldexp(1.0, -40);
+        const double lower = std::max(min, cdf_type::lower(m_distribution));
+        const double upper = std::min(max, cdf_type::upper(m_distribution));
+        m_lower = lower;
+        m_upper = upper;
+        m_low_cut = std::isfinite(lower) ? 0.0 : tail;
+        m_high_cut = std::isfinite(upper) ? 0.0 : tail;
+
+        const double p_low = std::isfinite(lower) ? cdf_type::cdf(m_distribution, lower) : 0.0;
+        const double p_high = std::isfinite(upper) ? cdf_type::cdf(m_distribution, upper) : 1.0;
+        if (!(lower < upper) || !(p_low < p_high)) {
+          throw std::runtime_error("The truncation interval [" + std::to_string(min) + ", "
+            + std::to_string(max) + "] has zero probability");
+        }
+        m_p_low = p_low;
+        m_p_high = p_high;
+
+        m_table.resize(table_intervals + 1);
+        m_table.front() = std::isfinite(lower) ? lower
+          : inverse_cdf(m_distribution, p_low + tail, -std::numeric_limits<double>::infinity());
+        for (uint32_t i = 1; i < table_intervals; ++i) {
+          const double p = p_low + (p_high - p_low) * (static_cast<double>(i) / table_intervals);
+          m_table[i] = std::max(m_table[i - 1], inverse_cdf(m_distribution, p, m_table[i - 1]));
+        }
+        m_table.back() = std::isfinite(upper) ? upper
+          : std::max(m_table[table_intervals - 1],
+            inverse_cdf(m_distribution, p_high - tail, m_table[table_intervals - 1]));
+      }
+
+      Distribution m_distribution;
+      std::vector<double> m_table;
+      double m_lower;
+      double m_upper;
+      double m_p_low;   // cdf at the lower bound
+      double m_p_high;  // cdf at the upper bound
+      double m_low_cut; // probability of the lower tail that is cut off
+      double m_high_cut;
+      TargetGdalType m_lowest;
+      TargetGdalType m_highest;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,151 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Block generator that sets the missing cells of another block generator to
+// the nodata value, in the same pass as the values are generated. Blocks that
+// are missing entirely are not generated at all.
+//
+// The values of the cells that are not missing are those of the wrapped
+// generator, and so are the statistics, as they describe the valid values.
+
+#pragma once
+
+#include <pronto/raster/block_generator_interface.h>
+#include <pronto/raster/nodata_mask.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace pronto {
+  namespace raster {
+
+    template<typename TargetGdalType>
+    class nodata_block_generator : public block_generator_interface
+    {
+    public:
+      nodata_block_generator(std::unique_ptr<block_generator_interface> generator, const nodata_mask& mask,
+        int rows, int cols, int block_rows, int block_cols)
+        : m_generator(std::move(generator))
+        , m_mask(mask)
+        , m_rows(rows)
+        , m_cols(cols)
+        , m_block_rows(block_rows)
+        , m_block_cols(block_cols)
+      {
+      }
+
+      void fill_block(int major_row, int major_col, void* block, size_t block_size) override
+      {
+        const int first_row = major_row * m_block_rows;
+        const int first_col = major_col * m_block_cols;
+        const int valid_rows = std::min(m_block_rows, m_rows - first_row);
+        const int valid_cols = std::min(m_block_cols, m_cols - first_col);
+        constexpr std::ptrdiff_t value_size = sizeof(TargetGdalType);
+        if (m_mask.block_is_missing(major_row, major_col)) {
+          TargetGdalType* block_begin = static_cast<TargetGdalType*>(block);
+          std::fill(block_begin, block_begin + block_size, TargetGdalType{});
+          fill_nodata(valid_rows, valid_cols, block, value_size, m_block_cols * value_size);
+          return;
+        }
+        m_generator->fill_block(major_row, major_col, block, block_size);
+        if (!m_mask.block_is_complete(major_row, major_col)) {
+          m_mask.apply<TargetGdalType>(first_row, first_col, valid_rows, valid_cols, block,
+            value_size, m_block_cols * value_size);
+        }
+      }
+
+      void fill_window(int first_row, int first_col, int rows, int cols, void* buffer,
+        std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) override
+      {
+        if (rows <= 0 || cols <= 0) {
+          return;
+        }
+        const int major_row = first_row / m_block_rows;
+        const int major_col = first_col / m_block_cols;
+        const bool in_one_block = (first_row + rows - 1) / m_block_rows == major_row
+          && (first_col + cols - 1) / m_block_cols == major_col;
+        if (in_one_block && m_mask.block_is_missing(major_row, major_col)) {
+          fill_nodata(rows, cols, buffer, pixel_space, line_space);
+          return;
+        }
+        m_generator->fill_window(first_row, first_col, rows, cols, buffer, pixel_space, line_space);
+        if (!in_one_block || !m_mask.block_is_complete(major_row, major_col)) {
+          m_mask.apply<TargetGdalType>(first_row, first_col, rows, cols, buffer, pixel_space, line_space);
+        }
+      }
+
+      bool pixel_addressable() const override
+      {
+        return m_generator->pixel_addressable();
+      }
+
+      void fill_sampled(const int* rows, int num_rows, const int* cols, int num_cols,
+        void* buffer, std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) override
+      {
+        m_generator->fill_sampled(rows, num_rows, cols, num_cols, buffer, pixel_space, line_space);
+        const TargetGdalType value = static_cast<TargetGdalType>(m_mask.value());
+        for (int r = 0; r < num_rows; ++r) {
+          char* row_begin = static_cast<char*>(buffer) + r * line_space;
+          for (int c = 0; c < num_cols; ++c) {
+            if (m_mask.is_missing(rows[r], cols[c])) {
+              std::memcpy(row_begin + c * pixel_space, &value, sizeof(TargetGdalType));
+            }
+          }
+        }
+      }
+
+      const value_distribution& get_value_distribution() const override
+      {
+        return m_generator->get_value_distribution();
+      }
+
+      double get_min() const override
+      {
+        return m_generator->get_min();
+      }
+
+      double get_max() const override
+      {
+        return m_generator->get_max();
+      }
+
+      double get_mean() const override
+      {
+        return m_generator->get_mean();
+      }
+
+      double get_std_dev() const override
+      {
+        return m_generator->get_std_dev();
+      }
+
+    private:
+      void fill_nodata(int rows, int cols, void* buffer, std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) const
+      {
+        const TargetGdalType value = static_cast<TargetGdalType>(m_mask.value());
+        for (int r = 0; r < rows; ++r) {
+          char* row_begin = static_cast<char*>(buffer) + r * line_space;
+          for (int c = 0; c < cols; ++c) {
+            std::memcpy(row_begin + c * pixel_space, &value, sizeof(TargetGdalType));
+          }
+        }
+      }
+
+      std::unique_ptr<block_generator_interface> m_generator;
+      nodata_mask m_mask;
+      int m_rows;
+      int m_cols;
+      int m_block_rows;
+      int m_block_cols;
+    };
+
+  } // namespace raster
+} // namespace pronto
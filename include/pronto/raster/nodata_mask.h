@@ -0,0 +1,141 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// The cells of a dataset that are missing, i.e. hold the nodata value.
+// Whether a cell is missing is a pure function of the seed and its position,
+// so the mask of any window is known without generating the values, and it
+// is the same for all bands.
+//
+// With the pixel pattern each cell is missing with the given probability,
+// independently of the others. With the block pattern whole blocks are
+// missing with the given probability, which gives clustered gaps.
+
+#pragma once
+
+#include <pronto/raster/splitmix64.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace pronto {
+  namespace raster {
+
+    enum class nodata_pattern {
+      pixel, // Cells are missing independently.
+      block  // Whole blocks are missing.
+    };
+
+    class nodata_mask
+    {
+    public:
+      nodata_mask(uint64_t seed, double value, double probability, nodata_pattern pattern,
+        int block_rows, int block_cols)
+        : m_key(splitmix64::mix(seed ^ 0x6E6F646174614D4Bull)) // keeps the mask apart from the band streams
+        , m_value(value)
+        , m_probability(probability)
+        , m_threshold(static_cast<uint64_t>(std::ldexp(std::clamp(probability, 0.0, 1.0), 53)))
+        , m_pattern(pattern)
+        , m_block_rows(block_rows)
+        , m_block_cols(block_cols)
+      {
+      }
+
+      double value() const
+      {
+        return m_value;
+      }
+
+      double probability() const
+      {
+        return m_probability;
+      }
+
+      nodata_pattern pattern() const
+      {
+        return m_pattern;
+      }
+
+      bool is_missing(int row, int col) const
+      {
+        if (m_pattern == nodata_pattern::block) {
+          return block_is_missing(row / m_block_rows, col / m_block_cols);
+        }
+        return draw(row, col);
+      }
+
+      // True if every cell of the block is missing.
+      bool block_is_missing(int major_row, int major_col) const
+      {
+        if (m_pattern == nodata_pattern::block) {
+          return draw(major_row, major_col);
+        }
+        return m_threshold >= (uint64_t(1) << 53);
+      }
+
+      // True if no cell of the block is missing.
+      bool block_is_complete(int major_row, int major_col) const
+      {
+        if (m_pattern == nodata_pattern::block) {
+          return !draw(major_row, major_col);
+        }
+        return m_threshold == 0;
+      }
+
+      // Writes 0 for the missing cells of the window and 255 for the others.
+      // Value (r, c) is at r * line_space + c of buffer.
+      void fill_mask(int first_row, int first_col, int rows, int cols, unsigned char* buffer,
+        std::ptrdiff_t line_space) const
+      {
+        for (int r = 0; r < rows; ++r) {
+          unsigned char* row_begin = buffer + r * line_space;
+          for (int c = 0; c < cols; ++c) {
+            row_begin[c] = is_missing(first_row + r, first_col + c) ? 0 : 255;
+          }
+        }
+      }
+
+      // Sets the missing cells of a window of values of type T to the nodata
+      // value. Value (r, c) is at byte offset r * line_space + c * pixel_space
+      // of buffer.
+      template<typename T>
+      void apply(int first_row, int first_col, int rows, int cols, void* buffer,
+        std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) const
+      {
+        const T value = static_cast<T>(m_value);
+        for (int r = 0; r < rows; ++r) {
+          char* row_begin = static_cast<char*>(buffer) + r * line_space;
+          for (int c = 0; c < cols; ++c) {
+            if (is_missing(first_row + r, first_col + c)) {
+              std::memcpy(row_begin + c * pixel_space, &value, sizeof(T));
+            }
+          }
+        }
+      }
+
+    private:
+      bool draw(int row, int col) const
+      {
+        const uint64_t position = (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32)
+          | static_cast<uint32_t>(col);
+        return (splitmix64::mix(m_key + splitmix64::mix(position)) >> 11) < m_threshold;
+      }
+
+      uint64_t m_key;
+      double m_value;
+      double m_probability;
+      uint64_t m_threshold; // a draw of 53 bits below this is missing
+      nodata_pattern m_pattern;
+      int m_block_rows;
+      int m_block_cols;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,123 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Batched samplers for std::normal_distribution and 
+// std::lognormal_distribution, drawing chunks of standard normal variates 
+// with the ziggurat method.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/ziggurat_normal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+namespace pronto {
+  namespace raster {
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::normal_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::normal_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_mean(static_cast<double>(distribution.mean()))
+        , m_stddev(static_cast<double>(distribution.stddev()))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        double z[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_standard_normal(rng, z, n);
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(m_mean + m_stddev * z[i]);
+          }
+          first += n;
+        }
+      }
+
+      template<class EngineOf>
+      void fill_streams(const uint64_t* first_draws, EngineOf engine_of, TargetGdalType* out, std::size_t n) const
+      {
+        double z[sampler_chunk_size];
+        fill_standard_normal_streams(first_draws, engine_of, z, n);
+        for (std::size_t i = 0; i < n; ++i) {
+          out[i] = static_cast<TargetGdalType>(m_mean + m_stddev * z[i]);
+        }
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      distribution_type m_distribution;
+      double m_mean;
+      double m_stddev;
+    };
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::lognormal_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::lognormal_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_m(static_cast<double>(distribution.m()))
+        , m_s(static_cast<double>(distribution.s()))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        double z[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_standard_normal(rng, z, n);
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(std::exp(m_m + m_s * z[i]));
+          }
+          first += n;
+        }
+      }
+
+      template<class EngineOf>
+      void fill_streams(const uint64_t* first_draws, EngineOf engine_of, TargetGdalType* out, std::size_t n) const
+      {
+        double z[sampler_chunk_size];
+        fill_standard_normal_streams(first_draws, engine_of, z, n);
+        for (std::size_t i = 0; i < n; ++i) {
+          out[i] = static_cast<TargetGdalType>(std::exp(m_m + m_s * z[i]));
+        }
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      distribution_type m_distribution;
+      double m_m;
+      double m_s;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,80 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// PCG64 random engine, the 128-bit LCG with XSL-RR output permutation
+// (O'Neill 2014). The increment of the LCG selects one of 2^127 distinct
+// streams, which is used to give every block its own stream at the cost of
+// two LCG steps. The 128-bit arithmetic is written out on two 64-bit halves
+// so that it does not rely on a compiler-specific 128-bit integer type.
+
+#pragma once
+
+#include <pronto/raster/wide_multiply.h>
+
+#include <cstdint>
+
+namespace pronto {
+  namespace raster {
+
+    class pcg64_engine
+    {
+    public:
+      using result_type = uint64_t;
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~result_type(0); }
+
+      explicit pcg64_engine(uint64_t seed = 0, uint64_t stream = 0)
+        : m_state_hi(0), m_state_lo(0)
+        , m_increment_hi((stream >> 63))
+        , m_increment_lo((stream << 1) | 1u)
+      {
+        step();
+        m_state_lo += seed;
+        m_state_hi += (m_state_lo < seed) ? 1 : 0;
+        step();
+      }
+
+      result_type operator()()
+      {
+        step();
+        const uint64_t value = m_state_hi ^ m_state_lo;
+        const int rot = static_cast<int>(m_state_hi >> 58);
+        return (value >> rot) | (value << ((64 - rot) & 63));
+      }
+
+      void discard(unsigned long long n)
+      {
+        for (; n > 0; --n) {
+          step();
+        }
+      }
+
+    private:
+      // state = state * multiplier + increment (mod 2^128)
+      void step()
+      {
+        const uint64_t multiplier_hi = 0x2360ED051FC65DA4ull;
+        const uint64_t multiplier_lo = 0x4385DF649FCCF645ull;
+
+        uint64_t hi;
+        const uint64_t lo = mul_hi_lo(m_state_lo, multiplier_lo, hi);
+        hi += m_state_hi * multiplier_lo + m_state_lo * multiplier_hi;
+
+        m_state_lo = lo + m_increment_lo;
+        m_state_hi = hi + m_increment_hi + ((m_state_lo < lo) ? 1 : 0);
+      }
+
+      uint64_t m_state_hi;
+      uint64_t m_state_lo;
+      uint64_t m_increment_hi;
+      uint64_t m_increment_lo;
+    };
+
+  } // namespace raster
+} // namespace pronto
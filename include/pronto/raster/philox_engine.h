@@ -0,0 +1,94 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Philox4x64-10 counter-based random engine (Salmon et al. 2011, "Parallel
+// random numbers: as easy as 1, 2, 3"). The output is a pure function of a
+// 128-bit key and a 256-bit counter, so setting up a stream for a block costs
+// nothing and any block can be generated independently of all others.
+//
+// The first three counter words identify the stream, the fourth word counts
+// the 4-word output blocks within the stream. The engine satisfies the
+// UniformRandomBitGenerator requirements and can be used with the standard
+// library distributions.
+
+#pragma once
+
+#include <pronto/raster/wide_multiply.h>
+
+#include <array>
+#include <cstdint>
+
+namespace pronto {
+  namespace raster {
+
+    class philox4x64_engine
+    {
+    public:
+      using result_type = uint64_t;
+      using counter_type = std::array<uint64_t, 4>;
+      using key_type = std::array<uint64_t, 2>;
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~result_type(0); }
+
+      explicit philox4x64_engine(uint64_t key0 = 0, uint64_t key1 = 0,
+        uint64_t counter0 = 0, uint64_t counter1 = 0, uint64_t counter2 = 0)
+        : m_key{ key0, key1 }
+        , m_counter{ counter0, counter1, counter2, 0 }
+        , m_output{}
+        , m_index(4)
+      {
+      }
+
+      result_type operator()()
+      {
+        if (m_index == 4) {
+          m_output = generate(m_counter, m_key);
+          ++m_counter[3];
+          m_index = 0;
+        }
+        return m_output[m_index++];
+      }
+
+      void discard(unsigned long long n)
+      {
+        while (n > 0 && m_index < 4) {
+          ++m_index;
+          --n;
+        }
+        m_counter[3] += n / 4;
+        for (n %= 4; n > 0; --n) {
+          operator()();
+        }
+      }
+
+      // The stateless bijection at the heart of the engine.
+      static counter_type generate(counter_type counter, key_type key)
+      {
+        for (int round = 0; round < 10; ++round) {
+          if (round > 0) {
+            key[0] += 0x9E3779B97F4A7C15ull;
+            key[1] += 0xBB67AE8584CAA73Bull;
+          }
+          uint64_t hi0, hi1;
+          const uint64_t lo0 = mul_hi_lo(0xD2E7470EE14C6C93ull, counter[0], hi0);
+          const uint64_t lo1 = mul_hi_lo(0xCA5A826395121157ull, counter[2], hi1);
+          counter = { hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0 };
+        }
+        return counter;
+      }
+
+    private:
+      key_type m_key;
+      counter_type m_counter;
+      counter_type m_output;
+      int m_index;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -11,17 +11,38 @@
 
 #pragma once
 
+#include <pronto/raster/block_engine.h>
 #include <pronto/raster/block_generator_interface.h>
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/count_block_sampler.h>
+#include <pronto/raster/discrete_block_sampler.h>
+#include <pronto/raster/distribution_statistics.h>
+#include <pronto/raster/gamma_block_sampler.h>
+#include <pronto/raster/normal_block_sampler.h>
+#include <pronto/raster/uniform_int_block_sampler.h>
+#include <pronto/raster/uniform_real_block_sampler.h>
 
 #include <algorithm> // For std::min and std::max
 #include <cmath> // For std::sqrt
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits> 
 #include <random>
+#include <utility>
+#include <vector>
 
 namespace pronto {
   namespace raster {
 
-    template<class Distribution, typename TargetGdalType, class Generator = std::mt19937_64>
+    // How values are tied to the random streams.
+    enum class addressing_mode {
+      block, // One stream per block, values depend on the block size.
+      pixel  // One stream per pixel, values only depend on (seed, row, col).
+    };
+
+    template<class Distribution, typename TargetGdalType, class Generator = std::mt19937_64,
+      class Sampler = block_sampler<Distribution, TargetGdalType>>
     class random_block_generator : public block_generator_interface
     {
     public:
@@ -34,86 +55,297 @@ namespace pronto {
         //  
         // Note GDAL uses x_size and y_size, pronto raster uses rows (for x_size) 
         // and cols (for y_size)
+        //
+        // The Generator is created per block by block_engine<Generator>, 
+        // keyed on the base seed, the stream (band) and the block index.
+        // With pixel addressing it is created per pixel instead, keyed on 
+        // the base seed, the stream and the row and column.
 
 
       random_block_generator(uint64_t base_seed, int rows, int cols,
-        int block_rows, int block_cols, Distribution distribution)
+        int block_rows, int block_cols, Distribution distribution, 
+        addressing_mode addressing = addressing_mode::block,
+        uint64_t stream = 0)
         : m_base_seed(base_seed),
+        m_stream(stream),
+        m_addressing(addressing),
         m_rows(rows),
         m_cols(cols),
         m_block_rows(block_rows),
         m_block_cols(block_cols),
         m_blocks_in_row(1 + (cols - 1) / block_cols), // Calculate blocks per row
-        m_distribution(distribution)
+        m_sampler(distribution),
+        m_values(make_value_distribution<TargetGdalType>(m_sampler))
       {
       }
 
-      // Fills a block of data with random values.
+      // Uses a sampler that was set up by the caller, e.g. an 
+      // inverse_cdf_sampler.
+      random_block_generator(uint64_t base_seed, int rows, int cols,
+        int block_rows, int block_cols, Sampler sampler,
+        addressing_mode addressing = addressing_mode::block,
+        uint64_t stream = 0)
+        : m_base_seed(base_seed),
+        m_stream(stream),
+        m_addressing(addressing),
+        m_rows(rows),
+        m_cols(cols),
+        m_block_rows(block_rows),
+        m_block_cols(block_cols),
+        m_blocks_in_row(1 + (cols - 1) / block_cols), // Calculate blocks per row
+        m_sampler(std::move(sampler)),
+        m_values(make_value_distribution<TargetGdalType>(m_sampler))
+      {
+      }
+
+      // Fills a block of data with random values. For blocks on the right 
+      // and bottom edge of the raster only the part inside the raster is
+      // generated, the remainder is set to zero.
       void fill_block(int major_row, int major_col, void* block, size_t num_elements_in_block) override {
         
         // Cast the void pointer to the target GDAL data type pointer.
         TargetGdalType* block_begin = static_cast<TargetGdalType*>(block);
 
-        // Derives a unique seed for this block for reproducible results.
-        uint64_t block_seed = m_base_seed +
-          static_cast<uint64_t>(major_row) * m_blocks_in_row +
-          static_cast<uint64_t>(major_col);
-        
-        // Fill the block with random values using the distribution.
-        Generator rng(block_seed);
-        std::generate(block_begin, block_begin + num_elements_in_block,
-          [&]() {
-            return static_cast<TargetGdalType>(m_distribution(rng));
-          });
+        const int first_row = major_row * m_block_rows;
+        const int first_col = major_col * m_block_cols;
+        const int valid_rows = std::min(m_block_rows, m_rows - first_row);
+        const int valid_cols = std::min(m_block_cols, m_cols - first_col);
+        if (valid_rows < m_block_rows || valid_cols < m_block_cols) {
+          std::fill(block_begin, block_begin + num_elements_in_block, TargetGdalType{});
+        }
+
+        if (is_pixel_addressed()) {
+          fill_pixels(first_row, first_col, valid_rows, valid_cols, block,
+            sizeof(TargetGdalType), m_block_cols * sizeof(TargetGdalType));
+        }
+        else {
+          generate_block(major_row, major_col, valid_rows, valid_cols, block_begin, m_block_cols);
+        }
+      }
+
+      // Fills a window of the raster straight into the buffer of the caller. 
+      // With block addressing the blocks overlapping the window are generated
+      // in full, because values depend on the position in the stream of the 
+      // block. Blocks that lie inside the window are generated in place when 
+      // the layout of the buffer allows it, the others go through a scratch 
+      // block.
+      void fill_window(int first_row, int first_col, int rows, int cols, void* buffer,
+        std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) override
+      {
+        if (rows <= 0 || cols <= 0) {
+          return;
+        }
+        if (is_pixel_addressed()) {
+          fill_pixels(first_row, first_col, rows, cols, buffer, pixel_space, line_space);
+          return;
+        }
+
+        constexpr std::ptrdiff_t value_size = sizeof(TargetGdalType);
+        const bool packed = pixel_space == value_size && line_space % value_size == 0
+          && reinterpret_cast<std::uintptr_t>(buffer) % alignof(TargetGdalType) == 0;
+        std::vector<TargetGdalType> scratch;
+
+        const int last_row = first_row + rows;
+        const int last_col = first_col + cols;
+        for (int major_row = first_row / m_block_rows; major_row * m_block_rows < last_row; ++major_row) {
+          const int block_row = major_row * m_block_rows;
+          const int valid_rows = std::min(m_block_rows, m_rows - block_row);
+          const int row_begin = std::max(first_row, block_row);
+          const int row_end = std::min(last_row, block_row + valid_rows);
+
+          for (int major_col = first_col / m_block_cols; major_col * m_block_cols < last_col; ++major_col) {
+            const int block_col = major_col * m_block_cols;
+            const int valid_cols = std::min(m_block_cols, m_cols - block_col);
+            const int col_begin = std::max(first_col, block_col);
+            const int col_end = std::min(last_col, block_col + valid_cols);
+
+            char* target = static_cast<char*>(buffer)
+              + (row_begin - first_row) * line_space + (col_begin - first_col) * pixel_space;
+
+            // A block with full rows is generated by a single call and 
+            // therefore needs contiguous rows.
+            const bool in_place = packed
+              && row_begin == block_row && row_end == block_row + valid_rows
+              && col_begin == block_col && col_end == block_col + valid_cols
+              && (valid_cols < m_block_cols || line_space == m_block_cols * value_size);
+            if (in_place) {
+              generate_block(major_row, major_col, valid_rows, valid_cols,
+                reinterpret_cast<TargetGdalType*>(target), line_space / value_size);
+              continue;
+            }
+
+            scratch.resize(static_cast<size_t>(m_block_rows) * m_block_cols);
+            generate_block(major_row, major_col, valid_rows, valid_cols, scratch.data(), m_block_cols);
+            for (int r = row_begin; r < row_end; ++r) {
+              const TargetGdalType* source = scratch.data()
+                + static_cast<size_t>(r - block_row) * m_block_cols + (col_begin - block_col);
+              char* target_row = target + (r - row_begin) * line_space;
+              if (pixel_space == value_size) {
+                std::memcpy(target_row, source, (col_end - col_begin) * sizeof(TargetGdalType));
+              }
+              else {
+                for (int c = 0; c < col_end - col_begin; ++c) {
+                  std::memcpy(target_row + c * pixel_space, source + c, sizeof(TargetGdalType));
+                }
+              }
+            }
+          }
+        }
+      }
+
+      bool pixel_addressable() const override
+      {
+        return is_pixel_addressed();
+      }
+
+      void fill_sampled(const int* rows, int num_rows, const int* cols, int num_cols,
+        void* buffer, std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) override
+      {
+        if (!is_pixel_addressed()) {
+          return;
+        }
+        for (int r = 0; r < num_rows; ++r) {
+          generate_pixel_row(rows[r], [cols](int c) { return cols[c]; }, num_cols,
+            static_cast<char*>(buffer) + r * line_space, pixel_space);
+        }
       }
 
       // --- Statistical properties ---
-      // These methods provide the theoretical min/max/mean/std_dev of the distribution.
-      // They are accurate for bounded distributions (like uniform, bernoulli)
-      // but might not be meaningful or precise for unbounded ones (like normal, poisson with large mean).
+      // These derive from the exact distribution of the stored values, 
+      // which is known when the dataset is opened.
+      const value_distribution& get_value_distribution() const override {
+        return m_values;
+      }
+
       double get_min() const override {
-        try {
-          return static_cast<double>(m_distribution.min());
-        }
-        catch (const std::exception& e) {
-          return std::numeric_limits<double>::lowest();
+        if (m_values.available()) {
+          return m_values.expected_min(static_cast<uint64_t>(m_rows) * m_cols);
         }
+        return static_cast<double>(m_sampler.distribution().min());
       }
 
       double get_max() const override {
-        try {
-          return static_cast<double>(m_distribution.max());
-        }
-        catch (const std::exception& e) {
-          return std::numeric_limits<double>::max();
+        if (m_values.available()) {
+          return m_values.expected_max(static_cast<uint64_t>(m_rows) * m_cols);
         }
+        return static_cast<double>(m_sampler.distribution().max());
       }
 
       double get_mean() const override {
-        double min_val = get_min();
-        double max_val = get_max();
-        if (min_val != std::numeric_limits<double>::lowest() && max_val != std::numeric_limits<double>::max()) {
-          return (min_val + max_val) / 2.0;
-        }
-        return 0.0;
+        return m_values.has_moments() ? m_values.mean() : std::numeric_limits<double>::quiet_NaN();
       }
 
       double get_std_dev() const override {
-        double range = get_max() - get_min();
-        if (range >= 0) {
-          return range / std::sqrt(12.0);
-        }
-        return 0.0;
+        return m_values.has_moments() ? m_values.std_dev() : std::numeric_limits<double>::quiet_NaN();
       }
 
     private:
+      bool is_pixel_addressed() const
+      {
+        if constexpr (block_engine<Generator>::pixel_addressable) {
+          return m_addressing == addressing_mode::pixel;
+        }
+        return false;
+      }
+
+      // Generates the valid part of a block with its own engine. Rows are 
+      // line_stride values apart.
+      void generate_block(int major_row, int major_col, int valid_rows, int valid_cols,
+        TargetGdalType* first, std::ptrdiff_t line_stride) const
+      {
+        // Derives a unique engine for this block for reproducible results.
+        uint64_t block_index = 
+          static_cast<uint64_t>(major_row) * m_blocks_in_row +
+          static_cast<uint64_t>(major_col);
+        Generator rng = block_engine<Generator>::make(m_base_seed, m_stream, block_index);
+
+        // Fill the block with random values using the distribution.
+        if (valid_cols == m_block_cols) {
+          m_sampler.fill(rng, first, first + static_cast<size_t>(valid_rows) * m_block_cols);
+        }
+        else {
+          for (int r = 0; r < valid_rows; ++r) {
+            TargetGdalType* row_begin = first + r * line_stride;
+            m_sampler.fill(rng, row_begin, row_begin + valid_cols);
+          }
+        }
+      }
+
+      // Generates each pixel of a window with its own engine, see 
+      // fill_window for the layout of the buffer.
+      void fill_pixels(int first_row, int first_col, int rows, int cols, void* buffer,
+        std::ptrdiff_t pixel_space, std::ptrdiff_t line_space) const
+      {
+        for (int r = 0; r < rows; ++r) {
+          generate_pixel_row(first_row + r, [first_col](int c) { return first_col + c; }, cols,
+            static_cast<char*>(buffer) + r * line_space, pixel_space);
+        }
+      }
+
+      // Generates the pixels (row, col_of(0)) ... (row, col_of(cols - 1)) 
+      // into target, pixel_space bytes apart. Samplers with fill_streams 
+      // (see block_sampler.h) get the first draws of a chunk of pixels at 
+      // once, which is much faster than a fill per pixel. Both give the 
+      // same values.
+      template<class ColumnOf>
+      void generate_pixel_row(int row, ColumnOf col_of, int cols, char* target,
+        std::ptrdiff_t pixel_space) const
+      {
+        if constexpr (block_engine<Generator>::pixel_addressable
+          && has_fill_streams<Sampler, TargetGdalType, Generator>::value) {
+          uint64_t first_draws[sampler_chunk_size];
+          TargetGdalType values[sampler_chunk_size];
+          for (int first = 0; first < cols; first += static_cast<int>(sampler_chunk_size)) {
+            const std::size_t n = std::min<std::size_t>(cols - first, sampler_chunk_size);
+            auto engine_of = [&](std::size_t i) {
+              return block_engine<Generator>::make_for_pixel(m_base_seed, m_stream, row,
+                col_of(first + static_cast<int>(i)));
+              };
+            for (std::size_t i = 0; i < n; ++i) {
+              first_draws[i] = engine_of(i)();
+            }
+            m_sampler.fill_streams(first_draws, engine_of, values, n);
+
+            char* chunk_begin = target + first * pixel_space;
+            if (pixel_space == sizeof(TargetGdalType)) {
+              std::memcpy(chunk_begin, values, n * sizeof(TargetGdalType));
+            }
+            else {
+              for (std::size_t i = 0; i < n; ++i) {
+                std::memcpy(chunk_begin + i * pixel_space, values + i, sizeof(TargetGdalType));
+              }
+            }
+          }
+        }
+        else {
+          for (int c = 0; c < cols; ++c) {
+            generate_pixel(row, col_of(c), target + c * pixel_space);
+          }
+        }
+      }
+
+      // Generates a single pixel with its own engine, target need not be 
+      // aligned.
+      void generate_pixel(int row, int col, char* target) const
+      {
+        if constexpr (block_engine<Generator>::pixel_addressable) {
+          Generator rng = block_engine<Generator>::make_for_pixel(m_base_seed, m_stream, row, col);
+          TargetGdalType value;
+          m_sampler.fill(rng, &value, &value + 1);
+          std::memcpy(target, &value, sizeof(TargetGdalType));
+        }
+      }
+
       uint64_t     m_base_seed;
+      uint64_t     m_stream;
+      addressing_mode m_addressing;
       int      m_rows;
       int      m_cols;
       int      m_block_rows;
       int      m_block_cols;
       int      m_blocks_in_row;
-      Distribution   m_distribution;
+      Sampler m_sampler;
+      value_distribution m_values;
     };
 
   } // namespace raster
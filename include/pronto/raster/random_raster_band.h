@@ -11,9 +11,18 @@
 #include <gdal_priv.h>
 #include <gdal_pam.h>
 
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <pronto/raster/block_generator_interface.h>
+#include <pronto/raster/block_prefetcher.h>
 #include <pronto/raster/random_raster_dataset.h>
 #include <pronto/raster/random_raster_band.h>
+#include <pronto/raster/random_raster_overview_band.h>
+#include <pronto/raster/raster_moments.h>
 
 namespace pronto {
   namespace raster {
@@ -22,13 +31,100 @@ namespace pronto {
     // Represents a single band of a random_dataset, delegates data generation and statistics.
     class random_raster_band : public GDALPamRasterBand
     {
+      // Reads multi-band windows one block at a time across the bands.
+      friend class random_raster_dataset;
+
     private:
       // Non-owning pointer to the block generator owned by random_dataset.
       block_generator_interface* m_block_generator;
 
+      // Read-ahead for IReadBlock, null when disabled.
+      std::unique_ptr<block_prefetcher> m_prefetcher;
+
+      // Window announced by AdviseRead, generated in the background in the
+      // buffer type, with packed rows.
+      struct staged_window
+      {
+        int x_off;
+        int y_off;
+        int x_size;
+        int y_size;
+        GDALDataType type;
+        std::vector<GByte> data;
+        std::future<void> ready;
+        uint64_t values_read = 0;
+      };
+      std::unique_ptr<staged_window> m_staged;
+
+      // Virtual overviews, created on first use.
+      std::vector<std::unique_ptr<random_raster_overview_band>> m_overviews;
+      bool m_overviews_created = false;
+      void create_overviews();
+
+      // Generates a window at full resolution into the buffer, converting 
+      // to the buffer type if needed.
+      void read_window(int nXOff, int nYOff, int nXSize, int nYSize, void* pData,
+        GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace);
+
+      // As read_window, but split on block boundaries over the threads of 
+      // the pool, or in turn on the calling thread if pool is null.
+      void generate_window(int nXOff, int nYOff, int nXSize, int nYSize, void* pData,
+        GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace, thread_pool* pool);
+
+      // Copies the window from the staged window, if it is contained in it 
+      // and has the same type. Waits for the staged window to be generated,
+      // and releases it once as many values have been copied as it holds.
+      bool read_staged(int nXOff, int nYOff, int nXSize, int nYSize, void* pData,
+        GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace);
+
+      void discard_staged();
+
+      // Generates the block for the other bands of the dataset and places 
+      // it in their block cache, unless it is already there.
+      void fill_sibling_blocks(int nBlockXOff, int nBlockYOff);
+
+      // Moments of the blocks that have been generated, kept so that the 
+      // sample statistics are known once every block has been generated.
+      std::mutex m_moments_mutex;
+      std::vector<raster_moments> m_block_moments;
+      std::vector<bool> m_block_observed;
+      size_t m_blocks_observed = 0;
+
+      // Accumulates the moments of the valid part of a block, unless they 
+      // are already known. Value (r, c) of the block is at byte offset 
+      // r * line_space + c * pixel_space of data.
+      void observe_block(int major_row, int major_col, const void* data,
+        GSpacing pixel_space, GSpacing line_space);
+
+      // The moments of the band, if every block has been observed.
+      bool observed_moments(raster_moments& moments);
+
+      // Generates the blocks that have not been observed, on the threads of
+      // the dataset, and provides the moments of the band. Progress is 
+      // reported per row of blocks, returns false if it is cancelled.
+      bool compute_moments(raster_moments& moments, GDALProgressFunc pfnProgress, void* pProgressData);
+
+      // Sets the statistics in the PAM metadata, so that they are saved 
+      // with the dataset.
+      void publish_statistics(const raster_moments& moments);
+
+      // Expected number of valid values, i.e. excluding the missing cells.
+      uint64_t expected_valid_count() const;
+
     protected:
       CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void* p_data) override;
 
+      // Follows from the nodata mask: blocks that are missing entirely are
+      // reported as empty, without generating them.
+      int IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize, int nYSize,
+        int nMaskFlagStop, double* pdfDataPct) override;
+
+      // Reads without resampling are generated straight into the buffer of
+      // the caller, bypassing the block cache.
+      CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+        void* pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+        GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg* psExtraArg) override;
+
     public:
       random_raster_band(
         random_raster_dataset* ds, 
@@ -37,13 +133,61 @@ namespace pronto {
         GDALDataType data_type, 
         int block_rows, int block_cols);
       
-      ~random_raster_band() override = default;
+      ~random_raster_band() override;
+
+      // Prefetches depth blocks ahead on the background workers of the 
+      // dataset once blocks are read sequentially, a depth of 0 disables it.
+      void set_prefetch(int depth, background_workers* workers);
+
+      // Stops prefetching and waits for any staged window, so that the block
+      // generator is no longer in use.
+      void stop_background_work();
+
+      // Starts generating the window in the background, so that it is ready
+      // for subsequent reads of (parts of) it.
+      CPLErr AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+        int nBufXSize, int nBufYSize, GDALDataType eBufType, CSLConstList papszOptions) override;
+
+      // Reports the prefetch HITS, MISSES and HIT_RATE in the PREFETCH 
+      // domain.
+      const char* GetMetadataItem(const char* pszName, const char* pszDomain = "") override;
+
+      // Overviews by decimation, halving the size at each level until it 
+      // fits in a block. Only available with pixel addressing, as otherwise
+      // every decimated pixel would require generating a whole block.
+      int GetOverviewCount() override;
+      GDALRasterBand* GetOverview(int i) override;
+
+      // With nodata, all bands share a mask band that is computed without
+      // reading the band.
+      double GetNoDataValue(int* pbSuccess = nullptr) override;
+      GDALRasterBand* GetMaskBand() override;
+      int GetMaskFlags() override;
 
       // Overrides for GDALRasterBand properties, delegated to m_block_generator.
+      // The statistics and histograms follow from the distribution of the
+      // values, without reading the band. Sample statistics take precedence
+      // when they are known, i.e. when they have been computed or saved, or
+      // once every block has been generated. Where the statistics of the 
+      // distribution are not known (e.g. the mean of a cauchy distribution) 
+      // they are computed. Exact histograms (bApproxOK is FALSE) are 
+      // computed from the generated raster.
       double GetMinimum(int* pbSuccess = nullptr) override;
       double GetMaximum(int* pbSuccess = nullptr) override;
       CPLErr GetStatistics(int bApproxOK, int bForce, double* pdfMin, double* pdfMax,
           double* pdfMean, double* pdfStdDev) override;
+
+      // Exact sample statistics, generating the blocks on the threads of the
+      // dataset and accumulating their moments without retaining them. 
+      // Approximate statistics of bands with overviews are taken from an 
+      // overview.
+      CPLErr ComputeStatistics(int bApproxOK, double* pdfMin, double* pdfMax, double* pdfMean,
+        double* pdfStdDev, GDALProgressFunc pfnProgress, void* pProgressData) override;
+      CPLErr ComputeRasterMinMax(int bApproxOK, double* adfMinMax) override;
+      CPLErr GetHistogram(double dfMin, double dfMax, int nBuckets, GUIntBig* panHistogram,
+        int bIncludeOutOfRange, int bApproxOK, GDALProgressFunc pfnProgress, void* pProgressData) override;
+      CPLErr GetDefaultHistogram(double* pdfMin, double* pdfMax, int* pnBuckets, GUIntBig** ppanHistogram,
+        int bForce, GDALProgressFunc pfnProgress, void* pProgressData) override;
      };
 
   } // namespace raster
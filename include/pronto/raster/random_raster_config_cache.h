@@ -0,0 +1,63 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Cache of the definitions of recently opened configurations, so that
+// opening the same configuration again, e.g. as a source of a VRT mosaic
+// that closes and reopens its sources, neither parses the JSON nor builds
+// the tables of the generators again.
+//
+// The definitions are keyed by the contents of the configuration file. A
+// key of path and modification time would save reading the file, but
+// modification times have a resolution of a second and configurations are
+// small, and mostly held entirely in the header that GDAL reads anyway.
+//
+// The number of cached definitions is set by the RANDOM_RASTER_CONFIG_CACHE
+// configuration option, 256 by default, and 0 disables the cache. The least
+// recently used definitions are dropped first.
+
+#pragma once
+
+#include <pronto/raster/random_raster_definition.h>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace pronto {
+  namespace raster {
+
+    class random_raster_config_cache
+    {
+    public:
+      // The cache shared by all datasets.
+      static random_raster_config_cache& instance();
+
+      // The definition of the configuration with the given contents, null
+      // if it is not cached.
+      std::shared_ptr<const random_raster_definition> find(const std::string& contents);
+
+      // Caches the definition of the configuration with the given contents,
+      // if it is reproducible.
+      void insert(const std::string& contents, std::shared_ptr<const random_raster_definition> definition);
+
+    private:
+      using entry = std::pair<std::string, std::shared_ptr<const random_raster_definition>>;
+
+      static std::size_t capacity();
+
+      std::mutex m_mutex;
+      std::list<entry> m_entries; // most recently used first
+      std::unordered_map<std::string, std::list<entry>::iterator> m_index;
+    };
+
+  } // namespace raster
+} // namespace pronto
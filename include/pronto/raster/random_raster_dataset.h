@@ -9,39 +9,106 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <gdal_pam.h>
 #include <gdal_priv.h>
 
 #include <nlohmann/json.hpp>
 
+#include <pronto/raster/background_workers.h>
 #include <pronto/raster/block_generator_interface.h> 
+#include <pronto/raster/nodata_mask.h>
+#include <pronto/raster/random_raster_definition.h>
+#include <pronto/raster/thread_pool.h>
 
 namespace pronto {
   namespace raster {
      class random_raster_dataset : public GDALPamDataset
     {
     private:
-      // The owned block generator.
-      std::unique_ptr<block_generator_interface> m_block_generator;
+      // The block generators, one per band, which can be shared with other
+      // datasets opened from the same configuration.
+      std::vector<std::shared_ptr<block_generator_interface>> m_block_generators;
+
+      // Whether reading a block of one band also generates that block for 
+      // the other bands.
+      bool m_pixel_interleaved;
+
+      // Threads used for generating large reads, null when single threaded.
+      std::unique_ptr<thread_pool> m_thread_pool;
+
+      // Threads shared by the prefetchers of the bands, null without 
+      // prefetching.
+      std::unique_ptr<background_workers> m_prefetch_workers;
+
+      // The missing cells of all bands, null without nodata.
+      std::shared_ptr<const nodata_mask> m_nodata_mask;
+
+      // The mask band shared by all bands, created on first use.
+      std::unique_ptr<GDALRasterBand> m_mask_band;
   
       // Private constructor for internal use by factory methods.
-      random_raster_dataset(int rows, int cols, GDALDataType data_type,
-                    int block_rows, int block_cols, std::unique_ptr<block_generator_interface>&& block_generator);
+      explicit random_raster_dataset(const random_raster_definition& definition);
+
+    protected:
+      // Reads without resampling are passed on to the bands, which generate
+      // straight into the buffer of the caller.
+      CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+        void* pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+        int nBandCount, BANDMAP_TYPE panBandMap, GSpacing nPixelSpace, GSpacing nLineSpace,
+        GSpacing nBandSpace, GDALRasterIOExtraArg* psExtraArg) override;
 
     public:
       random_raster_dataset() = delete; // Disable default constructor.
-      ~random_raster_dataset() override = default;
+      ~random_raster_dataset() override;
 
       static GDALDataset* create_from_generator(
         int rows, int cols, GDALDataType data_type,
         int block_rows, int block_cols, std::unique_ptr<block_generator_interface>&& block_generator);
 
+      // Creates a band for each generator. With pixel_interleaved, reading
+      // a block of any band generates that block for all bands. With a mask,
+      // the generators are expected to set its missing cells to the nodata
+      // value, and the bands share it as their mask band.
+      static GDALDataset* create_from_generators(
+        int rows, int cols, const std::vector<GDALDataType>& data_types,
+        int block_rows, int block_cols, std::vector<std::unique_ptr<block_generator_interface>>&& block_generators,
+        bool pixel_interleaved, std::unique_ptr<nodata_mask>&& mask = nullptr);
+
+      static GDALDataset* create_from_definition(const random_raster_definition& definition);
       static GDALDataset* create_from_json(const nlohmann::json& json_params);
+
+      // Validates the configuration and makes the generators of its bands.
+      static std::shared_ptr<const random_raster_definition> definition_from_json(const nlohmann::json& json_params);
+
       static int Identify(GDALOpenInfo* openInfo);
       static GDALDataset* Open(GDALOpenInfo* openInfo);
       CPLErr GetGeoTransform(double* padfTransform) override;
       const OGRSpatialReference* GetSpatialRef() const override;
+
+      // Uses num_threads threads for generating reads that span several 
+      // blocks.
+      void set_num_threads(int num_threads);
+      thread_pool* get_thread_pool() const;
+
+      bool is_pixel_interleaved() const;
+
+      // The missing cells, null without nodata.
+      const nodata_mask* get_nodata_mask() const;
+
+      // The mask band shared by all bands, null without nodata.
+      GDALRasterBand* get_mask_band();
+
+      // Prefetches depth blocks ahead on num_threads background threads, 
+      // shared by the bands, when blocks are read sequentially. A depth of 
+      // 0 disables it.
+      void set_prefetch(int depth, int num_threads);
+
+      // Passes the announced window on to the bands.
+      CPLErr AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+        int nBufXSize, int nBufYSize, GDALDataType eBufType,
+        int nBandCount, int* panBandList, CSLConstList papszOptions) override;
       bool m_bIsVirtual;
     };
 
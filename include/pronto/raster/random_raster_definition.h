@@ -0,0 +1,51 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Everything a random raster dataset is made of, as read from its JSON
+// configuration: the size, the block size and the block generator of every
+// band. The block generators are immutable after construction, so a single
+// definition can be shared by any number of datasets, also on different
+// threads.
+
+#pragma once
+
+#include <pronto/raster/block_generator_interface.h>
+#include <pronto/raster/nodata_mask.h>
+
+#include <gdal.h>
+
+#include <memory>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    struct random_raster_definition
+    {
+      int rows = 0;
+      int cols = 0;
+      int block_rows = 0;
+      int block_cols = 0;
+
+      // The data type and block generator of each band.
+      std::vector<GDALDataType> data_types;
+      std::vector<std::shared_ptr<block_generator_interface>> block_generators;
+
+      bool pixel_interleaved = false;
+
+      // The missing cells of all bands, null without nodata.
+      std::shared_ptr<const nodata_mask> mask;
+
+      // Whether the values only depend on the configuration, i.e. all seeds
+      // are given. Otherwise every dataset opened from the configuration
+      // draws its own seed and the definition cannot be reused.
+      bool reproducible = false;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,40 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+#pragma once
+
+#include <gdal_priv.h>
+
+#include <pronto/raster/nodata_mask.h>
+
+namespace pronto {
+  namespace raster {
+
+    // --- random_raster_mask_band Class Definition ---
+    // Mask band shared by all bands of a random_dataset with nodata. It is 
+    // 255 for valid cells and 0 for missing cells, and follows from the
+    // nodata_mask without generating any values.
+    class random_raster_mask_band : public GDALRasterBand
+    {
+    private:
+      nodata_mask m_mask;
+
+    protected:
+      CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void* p_data) override;
+
+    public:
+      random_raster_mask_band(GDALDataset* ds, const nodata_mask& mask, int block_rows, int block_cols);
+
+      ~random_raster_mask_band() override = default;
+
+      // The mask itself has no missing cells.
+      int GetMaskFlags() override;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,65 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+#pragma once
+
+#include <gdal_priv.h>
+
+#include <vector>
+
+#include <pronto/raster/block_generator_interface.h>
+
+namespace pronto {
+  namespace raster {
+
+    // --- random_raster_overview_band Class Definition ---
+    // Virtual overview of a random_raster_band. Each overview pixel is the
+    // nearest full resolution pixel, which is generated on its own, so the
+    // cost is proportional to the size of the overview. Requires a pixel 
+    // addressable block generator.
+    class random_raster_overview_band : public GDALRasterBand
+    {
+    private:
+      // Non-owning pointer to the block generator owned by random_dataset.
+      block_generator_interface* m_block_generator;
+
+      // Full resolution row and column of each overview row and column.
+      std::vector<int> m_source_rows;
+      std::vector<int> m_source_cols;
+
+      void read_window(int nXOff, int nYOff, int nXSize, int nYSize, void* pData,
+        GSpacing nPixelSpace, GSpacing nLineSpace);
+
+    protected:
+      CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void* p_data) override;
+
+      // Reads without resampling are generated straight into the buffer of
+      // the caller.
+      CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+        void* pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+        GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg* psExtraArg) override;
+
+    public:
+      random_raster_overview_band(
+        GDALDataset* ds,
+        int n_band,
+        block_generator_interface* block_gen,
+        GDALDataType data_type,
+        int full_rows, int full_cols,
+        int rows, int cols,
+        int block_rows, int block_cols);
+
+      ~random_raster_overview_band() override = default;
+
+      // The nodata value of the full resolution band, the overview pixels 
+      // are missing where their full resolution pixels are.
+      double GetNoDataValue(int* pbSuccess = nullptr) override;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,124 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Count, mean, sum of squared deviations, minimum and maximum of a set of
+// values, as accumulated per block for the sample statistics of a band.
+//
+// The values of a block are converted to double in chunks and accumulated
+// by the accumulate_moments kernel, as sums shifted by the first value so
+// that the squares do not lose precision when the mean is far from zero.
+// The moments of blocks are merged with the pairwise formula of Chan,
+// Golub and LeVeque (1979). The values of a block are always accumulated in
+// the same order, and merging blocks in the same order gives the same
+// result, whichever threads accumulated the blocks.
+
+#pragma once
+
+#include <pronto/raster/simd_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace pronto {
+  namespace raster {
+
+    struct raster_moments
+    {
+      uint64_t count = 0;
+      double mean = 0.0;
+      double sum_squared_deviations = 0.0;
+      double min = std::numeric_limits<double>::infinity();
+      double max = -std::numeric_limits<double>::infinity();
+
+      // Population variance, as used by GDAL.
+      double variance() const
+      {
+        return count > 0 ? sum_squared_deviations / static_cast<double>(count) : 0.0;
+      }
+
+      void merge(const raster_moments& other)
+      {
+        if (other.count == 0) return;
+        if (count == 0) {
+          *this = other;
+          return;
+        }
+        const double n_a = static_cast<double>(count);
+        const double n_b = static_cast<double>(other.count);
+        const double n = n_a + n_b;
+        const double delta = other.mean - mean;
+        mean += delta * n_b / n;
+        sum_squared_deviations += other.sum_squared_deviations + delta * delta * n_a * n_b / n;
+        count += other.count;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+      }
+
+      // Moments of rows x cols values, of which value (r, c) is at byte
+      // offset r * line_space + c * pixel_space of data. NaN values and 
+      // values equal to nodata are skipped, a NaN nodata skips none.
+      template<typename T>
+      static raster_moments of(const void* data, int rows, int cols,
+        std::ptrdiff_t pixel_space, std::ptrdiff_t line_space, 
+        double nodata = std::numeric_limits<double>::quiet_NaN())
+      {
+        const simd_kernels& kernels = get_simd_kernels();
+        constexpr std::size_t chunk_size = 1024;
+        double chunk[chunk_size];
+        double sums[moment_lanes] = {};
+        double squares[moment_lanes] = {};
+        double mins[moment_lanes];
+        double maxs[moment_lanes];
+        std::fill(mins, mins + moment_lanes, std::numeric_limits<double>::infinity());
+        std::fill(maxs, maxs + moment_lanes, -std::numeric_limits<double>::infinity());
+
+        raster_moments moments;
+        double shift = 0.0;
+        std::size_t filled = 0;
+        for (int r = 0; r < rows; ++r) {
+          const char* row = static_cast<const char*>(data) + r * line_space;
+          for (int c = 0; c < cols; ++c) {
+            const double value = static_cast<double>(*reinterpret_cast<const T*>(row + c * pixel_space));
+            if (std::isnan(value) || value == nodata) continue;
+            if (moments.count == 0 && filled == 0) {
+              shift = value;
+            }
+            chunk[filled++] = value;
+            if (filled == chunk_size) {
+              kernels.accumulate_moments(chunk, filled, shift, sums, squares, mins, maxs);
+              moments.count += filled;
+              filled = 0;
+            }
+          }
+        }
+        kernels.accumulate_moments(chunk, filled, shift, sums, squares, mins, maxs);
+        moments.count += filled;
+        if (moments.count == 0) {
+          return moments;
+        }
+
+        double sum = 0.0;
+        double sum_squares = 0.0;
+        for (std::size_t lane = 0; lane < moment_lanes; ++lane) {
+          sum += sums[lane];
+          sum_squares += squares[lane];
+          moments.min = std::min(moments.min, mins[lane]);
+          moments.max = std::max(moments.max, maxs[lane]);
+        }
+        const double n = static_cast<double>(moments.count);
+        moments.mean = shift + sum / n;
+        moments.sum_squared_deviations = std::max(0.0, sum_squares - sum * sum / n);
+        return moments;
+      }
+    };
+
+  } // namespace raster
+} // namespace pronto
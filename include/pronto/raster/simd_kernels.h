@@ -0,0 +1,112 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Kernels that turn chunks of raw 64-bit engine output into random values.
+// The kernels are compiled once for each supported
+// instruction set and the best version for the CPU is selected when the
+// plugin is loaded. All versions produce bit-identical results.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pronto {
+  namespace raster {
+
+    // Number of independent accumulators of accumulate_moments.
+    constexpr std::size_t moment_lanes = 8;
+
+    struct simd_kernels
+    {
+      // out[i] = offset + scale * u[i], with u[i] in [0, 1) taken from 23
+      // bits. Each 64-bit word gives two values: out[2j] uses the high half
+      // of bits[j] and out[2j + 1] the low half, so bits holds (n + 1) / 2
+      // words.
+      void (*bits_to_float)(const uint64_t* bits, float* out, std::size_t n,
+        float offset, float scale);
+
+      // out[i] = offset + scale * u[i], with u[i] in [0, 1) taken from the
+      // 52 high bits of bits[i].
+      void (*bits_to_double)(const uint64_t* bits, double* out, std::size_t n,
+        double offset, double scale);
+
+      // Lemire's multiply-shift range reduction on the 32 high bits of
+      // bits[i]: out[i] = (hi32(bits[i]) * range) >> 32, which lies in
+      // [0, range). Returns the number of values for which the low half of
+      // the product is below threshold; these must be rejected and redrawn
+      // to obtain unbiased values.
+      std::size_t(*bits_to_offsets)(const uint64_t* bits, uint32_t* out,
+        std::size_t n, uint32_t range, uint32_t threshold);
+
+      // As bits_to_offsets, but for ranges of at most 2^16 and slicing each
+      // 64-bit word into four 16-bit values. With m = (n + 3) / 4 words,
+      // out[k * m + j] is taken from the k-th slice, counting from the high
+      // end, of bits[j]. Rejected values are set to 0xFFFF, which is never a
+      // valid offset when threshold > 0.
+      std::size_t(*bits_to_offsets16)(const uint64_t* bits, uint16_t* out,
+        std::size_t n, uint32_t range, uint32_t threshold);
+
+      // As bits_to_offsets16, for ranges of at most 2^8 and slicing each
+      // 64-bit word into eight 8-bit values, using m = (n + 7) / 8 words.
+      // Rejected values are set to 0xFF.
+      std::size_t(*bits_to_offsets8)(const uint64_t* bits, uint8_t* out,
+        std::size_t n, uint32_t range, uint32_t threshold);
+
+      // Alias table lookup (see discrete_block_sampler.h): out[i] is
+      // columns[i] if the low 32 bits of bits[i] are below
+      // thresholds[columns[i]], and aliases[columns[i]] otherwise.
+      void (*alias_lookup)(const uint64_t* bits, const uint32_t* columns,
+        uint32_t* out, std::size_t n, const uint32_t* thresholds,
+        const uint32_t* aliases);
+
+      // Linear interpolation in a table of intervals + 1 values (see
+      // inverse_cdf_sampler.h): with k + f = u[i] * intervals and u[i] in
+      // [0, 1) taken from the 52 high bits of bits[i],
+      // out[i] = table[k] + f * (table[k + 1] - table[k]).
+      void (*bits_to_table)(const uint64_t* bits, double* out, std::size_t n,
+        const double* table, uint32_t intervals);
+
+      // Fast path of the ziggurat method (see ziggurat_normal.h):
+      // out[i] = u(bits[i]) * layer_edges[layer(bits[i])]. Returns the number
+      // of values that fall outside the rectangle of their layer; these must
+      // be completed with ziggurat_normal_complete.
+      std::size_t(*bits_to_normal)(const uint64_t* bits, double* out,
+        std::size_t n, const double* layer_edges);
+
+      // Accumulates n values into moment_lanes lanes, value x[i] going to
+      // lane i % moment_lanes: sums[lane] += x[i] - shift,
+      // squares[lane] += (x[i] - shift)^2, and the minimum and maximum in
+      // mins[lane] and maxs[lane]. Every lane adds its values in order, so
+      // that the result does not depend on the instruction set. n must be a
+      // multiple of moment_lanes, except for the last call.
+      void (*accumulate_moments)(const double* x, std::size_t n, double shift,
+        double* sums, double* squares, double* mins, double* maxs);
+
+      // y[i] += weight * x[i], the step of a convolution.
+      void (*multiply_add)(const double* x, std::size_t n, double weight, double* y);
+
+      // Gradient noise at the n points ((x + i) * x_step + x_offset, y) of a
+      // row, in lattice units, with out[i] in [-1, 1]. The gradients of the
+      // lattice points are hashed from their integer coordinates and seed,
+      // which must lie within the range of int32_t. See
+      // coherent_noise_field.h.
+      void (*perlin_noise)(double x, double x_step, double x_offset, double y, std::size_t n,
+        uint32_t seed, double* out);
+      void (*simplex_noise)(double x, double x_step, double x_offset, double y, std::size_t n,
+        uint32_t seed, double* out);
+
+      // Name of the instruction set, for diagnostics.
+      const char* name;
+    };
+
+    // The kernels for the best instruction set supported by the CPU.
+    const simd_kernels& get_simd_kernels();
+
+  } // namespace raster
+} // namespace pronto
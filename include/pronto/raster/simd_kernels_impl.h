@@ -0,0 +1,310 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Implementation of the SIMD kernels. This file is included by one
+// translation unit per instruction set, each compiled with its own target
+// flags and each defining PRONTO_RASTER_KERNEL_ISA as the namespace to put
+// the kernels in. The loops are written to be auto-vectorized: they only
+// use integer shifts, 32 x 32 -> 64 bit multiplications, table lookups,
+// conversions between 32-bit integers and doubles and reinterpreting bit
+// patterns as floating point numbers, all of which map to SIMD instructions
+// (table lookups to gathers from AVX2 onwards).
+
+#pragma once
+
+#ifndef PRONTO_RASTER_KERNEL_ISA
+#error "Define PRONTO_RASTER_KERNEL_ISA before including simd_kernels_impl.h"
+#endif
+
+#include <pronto/raster/simd_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#define PRONTO_RASTER_KERNEL_STRINGIFY_(x) #x
+#define PRONTO_RASTER_KERNEL_STRINGIFY(x) PRONTO_RASTER_KERNEL_STRINGIFY_(x)
+
+namespace pronto {
+  namespace raster {
+    namespace PRONTO_RASTER_KERNEL_ISA {
+
+      static void bits_to_float(const uint64_t* bits, float* out, std::size_t n,
+        float offset, float scale)
+      {
+        for (std::size_t i = 0; i < n; ++i) {
+          // 23 random bits as the mantissa of a float in [1, 2)
+          const unsigned shift = (i & 1) ? 9 : 41;
+          const uint32_t pattern = static_cast<uint32_t>((bits[i >> 1] >> shift) & 0x7FFFFF)
+            | 0x3F800000u;
+          float one_to_two;
+          std::memcpy(&one_to_two, &pattern, sizeof(float));
+          out[i] = offset + scale * (one_to_two - 1.0f);
+        }
+      }
+
+      static void bits_to_double(const uint64_t* bits, double* out, std::size_t n,
+        double offset, double scale)
+      {
+        for (std::size_t i = 0; i < n; ++i) {
+          // 52 random bits as the mantissa of a double in [1, 2)
+          const uint64_t pattern = (bits[i] >> 12) | 0x3FF0000000000000ull;
+          double one_to_two;
+          std::memcpy(&one_to_two, &pattern, sizeof(double));
+          out[i] = offset + scale * (one_to_two - 1.0);
+        }
+      }
+
+      static std::size_t bits_to_offsets(const uint64_t* bits, uint32_t* out,
+        std::size_t n, uint32_t range, uint32_t threshold)
+      {
+        std::size_t rejected = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+          const uint64_t product = (bits[i] >> 32) * range;
+          out[i] = static_cast<uint32_t>(product >> 32);
+          rejected += static_cast<uint32_t>(product) < threshold ? 1 : 0;
+        }
+        return rejected;
+      }
+
+      // Lemire's method on the slice_bits wide slices of the words, see
+      // simd_kernels.h for the order of the slices. Each pass takes one 
+      // slice from every word, so the loops only use a fixed shift.
+      template<typename Offset>
+      static std::size_t bits_to_sliced_offsets(const uint64_t* bits, Offset* out,
+        std::size_t n, uint32_t range, uint32_t threshold)
+      {
+        constexpr unsigned slice_bits = 8 * sizeof(Offset);
+        constexpr unsigned slices_per_word = 64 / slice_bits;
+        constexpr uint32_t mask = (uint32_t(1) << slice_bits) - 1;
+        const std::size_t words = (n + slices_per_word - 1) / slices_per_word;
+
+        std::size_t rejected = 0;
+        for (unsigned k = 0; k < slices_per_word && k * words < n; ++k) {
+          const unsigned shift = 64 - slice_bits * (k + 1);
+          const std::size_t count = std::min(words, n - k * words);
+          Offset* pass_out = out + k * words;
+          for (std::size_t j = 0; j < count; ++j) {
+            const uint32_t product = static_cast<uint32_t>((bits[j] >> shift) & mask) * range;
+            const bool reject = (product & mask) < threshold;
+            pass_out[j] = static_cast<Offset>(reject ? mask : product >> slice_bits);
+            rejected += reject ? 1 : 0;
+          }
+        }
+        return rejected;
+      }
+
+      static std::size_t bits_to_offsets16(const uint64_t* bits, uint16_t* out,
+        std::size_t n, uint32_t range, uint32_t threshold)
+      {
+        return bits_to_sliced_offsets(bits, out, n, range, threshold);
+      }
+
+      static std::size_t bits_to_offsets8(const uint64_t* bits, uint8_t* out,
+        std::size_t n, uint32_t range, uint32_t threshold)
+      {
+        return bits_to_sliced_offsets(bits, out, n, range, threshold);
+      }
+
+      static void alias_lookup(const uint64_t* bits, const uint32_t* columns,
+        uint32_t* out, std::size_t n, const uint32_t* thresholds,
+        const uint32_t* aliases)
+      {
+        for (std::size_t i = 0; i < n; ++i) {
+          const uint32_t column = columns[i];
+          const uint32_t coin = static_cast<uint32_t>(bits[i]);
+          out[i] = coin < thresholds[column] ? column : aliases[column];
+        }
+      }
+
+      static void bits_to_table(const uint64_t* bits, double* out, std::size_t n,
+        const double* table, uint32_t intervals)
+      {
+        const double scale = static_cast<double>(intervals);
+        for (std::size_t i = 0; i < n; ++i) {
+          // 52 random bits as the mantissa of a double in [1, 2)
+          const uint64_t pattern = (bits[i] >> 12) | 0x3FF0000000000000ull;
+          double one_to_two;
+          std::memcpy(&one_to_two, &pattern, sizeof(double));
+          const double position = (one_to_two - 1.0) * scale;
+          const uint32_t k = std::min(static_cast<uint32_t>(position), intervals - 1);
+          const double fraction = position - static_cast<double>(k);
+          out[i] = table[k] + fraction * (table[k + 1] - table[k]);
+        }
+      }
+
+      static std::size_t bits_to_normal(const uint64_t* bits, double* out,
+        std::size_t n, const double* layer_edges)
+      {
+        std::size_t rejected = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+          const std::size_t layer = static_cast<std::size_t>(bits[i] & 0xFF);
+          // 52 random bits as the mantissa of a double in [2, 4)
+          const uint64_t pattern = (bits[i] >> 12) | 0x4000000000000000ull;
+          double two_to_four;
+          std::memcpy(&two_to_four, &pattern, sizeof(double));
+          const double x = (two_to_four - 3.0) * layer_edges[layer];
+          out[i] = x;
+          rejected += std::fabs(x) < layer_edges[layer + 1] ? 0 : 1;
+        }
+        return rejected;
+      }
+
+      static void accumulate_moments(const double* x, std::size_t n, double shift,
+        double* sums, double* squares, double* mins, double* maxs)
+      {
+        std::size_t i = 0;
+        for (; i + moment_lanes <= n; i += moment_lanes) {
+          for (std::size_t lane = 0; lane < moment_lanes; ++lane) {
+            const double value = x[i + lane];
+            const double deviation = value - shift;
+            sums[lane] += deviation;
+            squares[lane] += deviation * deviation;
+            mins[lane] = value < mins[lane] ? value : mins[lane];
+            maxs[lane] = value > maxs[lane] ? value : maxs[lane];
+          }
+        }
+        for (std::size_t lane = 0; i < n; ++i, ++lane) {
+          const double value = x[i];
+          const double deviation = value - shift;
+          sums[lane] += deviation;
+          squares[lane] += deviation * deviation;
+          mins[lane] = value < mins[lane] ? value : mins[lane];
+          maxs[lane] = value > maxs[lane] ? value : maxs[lane];
+        }
+      }
+
+      static void multiply_add(const double* x, std::size_t n, double weight, double* y)
+      {
+        for (std::size_t i = 0; i < n; ++i) {
+          y[i] += weight * x[i];
+        }
+      }
+
+      // Hash of a lattice point, from which its gradient is taken.
+      static inline uint32_t lattice_hash(int32_t i, int32_t j, uint32_t seed)
+      {
+        uint32_t h = seed ^ (static_cast<uint32_t>(i) * 0x9E3779B1u) ^ (static_cast<uint32_t>(j) * 0x85EBCA77u);
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        h *= 0x297A2D39u;
+        h ^= h >> 15;
+        return h;
+      }
+
+      // Floor of a lattice coordinate within the range of int32_t, by
+      // truncation as std::floor is not vectorized.
+      static inline int32_t lattice_floor(double x)
+      {
+        const int32_t truncated = static_cast<int32_t>(x);
+        return truncated - (x < static_cast<double>(truncated) ? 1 : 0);
+      }
+
+      // Dot product with one of eight unit gradients, 45 degrees apart. The
+      // low bit of the hash gives the sign of x, the next bit the sign of y
+      // for the diagonals and the axis otherwise, and the third bit selects
+      // between the diagonals and the axes. The gradient is computed rather
+      // than selected, so that the loops can be vectorized.
+      static inline double gradient_dot(uint32_t hash, double x, double y)
+      {
+        const double sign_x = 1.0 - 2.0 * static_cast<double>(static_cast<int32_t>(hash & 1u));
+        const double bit_y = static_cast<double>(static_cast<int32_t>((hash >> 1) & 1u));
+        const double diagonal = static_cast<double>(static_cast<int32_t>((hash >> 2) & 1u));
+        const double s = 0.70710678118654752;
+        const double gx = sign_x * (diagonal * s + (1.0 - diagonal) * (1.0 - bit_y));
+        const double gy = diagonal * s * (1.0 - 2.0 * bit_y) + (1.0 - diagonal) * bit_y * sign_x;
+        return gx * x + gy * y;
+      }
+
+      // Improved Perlin noise with the quintic fade. The largest value with
+      // unit gradients is sqrt(1/2), hence the scaling.
+      static void perlin_noise(double x, double x_step, double x_offset, double y, std::size_t n,
+        uint32_t seed, double* out)
+      {
+        const int32_t j = lattice_floor(y);
+        const double fy = y - static_cast<double>(j);
+        const double v = fy * fy * fy * (fy * (fy * 6.0 - 15.0) + 10.0);
+        // Converting 64 bit integers to double is not vectorized, n is the
+        // length of a row.
+        for (std::size_t k = 0; k < n; ++k) {
+          const double px = (x + static_cast<double>(static_cast<int32_t>(k))) * x_step + x_offset;
+          const int32_t i = lattice_floor(px);
+          const double fx = px - static_cast<double>(i);
+          const double u = fx * fx * fx * (fx * (fx * 6.0 - 15.0) + 10.0);
+          const double d00 = gradient_dot(lattice_hash(i, j, seed), fx, fy);
+          const double d10 = gradient_dot(lattice_hash(i + 1, j, seed), fx - 1.0, fy);
+          const double d01 = gradient_dot(lattice_hash(i, j + 1, seed), fx, fy - 1.0);
+          const double d11 = gradient_dot(lattice_hash(i + 1, j + 1, seed), fx - 1.0, fy - 1.0);
+          const double bottom = d00 + u * (d10 - d00);
+          const double top = d01 + u * (d11 - d01);
+          out[k] = 1.41421356237309505 * (bottom + v * (top - bottom));
+        }
+      }
+
+      static inline double simplex_corner(uint32_t hash, double x, double y)
+      {
+        // max(falloff, 0), without a select that the compiler would turn
+        // into a branch.
+        const double falloff = 0.5 - x * x - y * y;
+        const double t = 0.5 * (falloff + std::fabs(falloff));
+        const double t2 = t * t;
+        return t2 * t2 * gradient_dot(hash, x, y);
+      }
+
+      // Simplex noise on the skewed triangular lattice. The largest value
+      // with unit gradients is 1 / 99.2043, hence the scaling.
+      static void simplex_noise(double x, double x_step, double x_offset, double y, std::size_t n,
+        uint32_t seed, double* out)
+      {
+        const double skew = 0.36602540378443865;   // (sqrt(3) - 1) / 2
+        const double unskew = 0.21132486540518712; // (3 - sqrt(3)) / 6
+        // Converting 64 bit integers to double is not vectorized, n is the
+        // length of a row.
+        for (std::size_t k = 0; k < n; ++k) {
+          const double px = (x + static_cast<double>(static_cast<int32_t>(k))) * x_step + x_offset;
+          const double s = (px + y) * skew;
+          const int32_t i = lattice_floor(px + s);
+          const int32_t j = lattice_floor(y + s);
+          const double t = static_cast<double>(i + j) * unskew;
+          const double x0 = px - (static_cast<double>(i) - t);
+          const double y0 = y - (static_cast<double>(j) - t);
+          const int32_t i1 = x0 > y0 ? 1 : 0;
+          const int32_t j1 = 1 - i1;
+          const double x1 = x0 - static_cast<double>(i1) + unskew;
+          const double y1 = y0 - static_cast<double>(j1) + unskew;
+          const double x2 = x0 - 1.0 + 2.0 * unskew;
+          const double y2 = y0 - 1.0 + 2.0 * unskew;
+          out[k] = 99.2043 * (simplex_corner(lattice_hash(i, j, seed), x0, y0)
+            + simplex_corner(lattice_hash(i + i1, j + j1, seed), x1, y1)
+            + simplex_corner(lattice_hash(i + 1, j + 1, seed), x2, y2));
+        }
+      }
+
+      extern const simd_kernels kernels;
+      const simd_kernels kernels = {
+        &bits_to_float,
+        &bits_to_double,
+        &bits_to_offsets,
+        &bits_to_offsets16,
+        &bits_to_offsets8,
+        &alias_lookup,
+        &bits_to_table,
+        &bits_to_normal,
+        &accumulate_moments,
+        &multiply_add,
+        &perlin_noise,
+        &simplex_noise,
+        PRONTO_RASTER_KERNEL_STRINGIFY(PRONTO_RASTER_KERNEL_ISA)
+      };
+
+    } // namespace PRONTO_RASTER_KERNEL_ISA
+  } // namespace raster
+} // namespace pronto
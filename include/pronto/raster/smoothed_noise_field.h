@@ -0,0 +1,153 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Spatial field that smooths the white noise of a pixel addressed block
+// generator with a separable kernel. The value of a cell is the weighted
+// mean of the noise in the square of the kernel radius around it.
+//
+// The noise of the halo around a block is regenerated from the pixel seeds
+// of the generator, also outside the raster, so every block is generated on
+// its own. The kernel is applied along the rows and then along the columns,
+// each as a series of multiply_add kernels.
+
+#pragma once
+
+#include <pronto/raster/block_generator_interface.h>
+#include <pronto/raster/simd_kernels.h>
+#include <pronto/raster/spatial_field.h>
+#include <pronto/raster/value_distribution.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    enum class smoothing_kernel {
+      box,         // equal weights
+      gaussian,    // exp(-(d / s)^2 / 2), with s a third of the radius
+      exponential  // exp(-|d| / s), with s a third of the radius
+    };
+
+    // The weights of the 2 * radius + 1 offsets of the kernel along one
+    // axis, adding up to one.
+    inline std::vector<double> smoothing_weights(smoothing_kernel kernel, int radius)
+    {
+      const double scale = radius / 3.0;
+      std::vector<double> weights(2 * static_cast<std::size_t>(radius) + 1);
+      double sum = 0.0;
+      for (int d = -radius; d <= radius; ++d) {
+        double weight = 1.0;
+        if (kernel == smoothing_kernel::gaussian) {
+          weight = std::exp(-0.5 * (d / scale) * (d / scale));
+        }
+        else if (kernel == smoothing_kernel::exponential) {
+          weight = std::exp(-std::abs(d) / scale);
+        }
+        weights[d + radius] = weight;
+        sum += weight;
+      }
+      for (double& weight : weights) {
+        weight /= sum;
+      }
+      return weights;
+    }
+
+    // NoiseType is the data type of the values of the noise generator.
+    template<typename NoiseType>
+    class smoothed_noise_field : public spatial_field
+    {
+    public:
+      smoothed_noise_field(std::unique_ptr<block_generator_interface> noise, smoothing_kernel kernel, int radius)
+        : m_noise(std::move(noise))
+        , m_radius(radius)
+        , m_weights(smoothing_weights(kernel, radius))
+      {
+        // The smoothed values have the mean of the noise and a variance
+        // reduced by the squared weights. Their distribution is
+        // approximated by the normal distribution within the support of the
+        // noise, which is exact for normal noise.
+        const value_distribution& noise_values = m_noise->get_value_distribution();
+        if (noise_values.has_moments()) {
+          double sum_squares = 0.0;
+          for (double weight : m_weights) {
+            sum_squares += weight * weight;
+          }
+          const double mean = noise_values.mean();
+          const double stddev = noise_values.std_dev() * sum_squares;
+          const double lower = noise_values.lower();
+          const double upper = noise_values.upper();
+          auto cdf = [=](double x) {
+            if (x < lower) return 0.0;
+            if (x >= upper) return 1.0;
+            if (stddev == 0.0) return x < mean ? 0.0 : 1.0;
+            return 0.5 * std::erfc(-(x - mean) / (stddev * std::sqrt(2.0)));
+            };
+          m_values = value_distribution(cdf, lower, upper, mean, stddev * stddev, false);
+        }
+      }
+
+      void generate(int first_row, int first_col, int rows, int cols, double* values,
+        std::ptrdiff_t line_stride) const override
+      {
+        const simd_kernels& kernels = get_simd_kernels();
+        const int taps = 2 * m_radius + 1;
+        const int halo_rows = rows + 2 * m_radius;
+        const int halo_cols = cols + 2 * m_radius;
+
+        std::vector<NoiseType> raw(static_cast<std::size_t>(halo_rows) * halo_cols);
+        m_noise->fill_window(first_row - m_radius, first_col - m_radius, halo_rows, halo_cols, raw.data(),
+          sizeof(NoiseType), static_cast<std::ptrdiff_t>(halo_cols) * sizeof(NoiseType));
+        std::vector<double> noise(raw.begin(), raw.end());
+
+        // Along the rows, for all rows of the halo.
+        std::vector<double> smoothed_rows(static_cast<std::size_t>(halo_rows) * cols, 0.0);
+        for (int r = 0; r < halo_rows; ++r) {
+          const double* source = noise.data() + static_cast<std::size_t>(r) * halo_cols;
+          double* target = smoothed_rows.data() + static_cast<std::size_t>(r) * cols;
+          for (int k = 0; k < taps; ++k) {
+            kernels.multiply_add(source + k, cols, m_weights[k], target);
+          }
+        }
+
+        // Along the columns, combining whole rows.
+        for (int r = 0; r < rows; ++r) {
+          double* target = values + r * line_stride;
+          std::fill(target, target + cols, 0.0);
+          for (int k = 0; k < taps; ++k) {
+            kernels.multiply_add(smoothed_rows.data() + static_cast<std::size_t>(r + k) * cols, cols,
+              m_weights[k], target);
+          }
+        }
+      }
+
+      // A single cell needs the noise of the whole kernel.
+      bool pixel_addressable() const override
+      {
+        return false;
+      }
+
+      const value_distribution& get_value_distribution() const override
+      {
+        return m_values;
+      }
+
+    private:
+      std::unique_ptr<block_generator_interface> m_noise;
+      int m_radius;
+      std::vector<double> m_weights;
+      value_distribution m_values;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,45 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Abstract base class for spatially correlated fields. Unlike the 
+// distributions, where every value is drawn independently, the value of a 
+// cell depends on its neighbourhood. A field is a function of the position
+// of the cells, so that any block can be generated on its own.
+
+#pragma once
+
+#include <pronto/raster/value_distribution.h>
+
+#include <cstddef>
+
+namespace pronto {
+  namespace raster {
+
+    class spatial_field {
+    public:
+      virtual ~spatial_field() = default;
+
+      // Writes the value of cell (first_row + r, first_col + c) to 
+      // values[r * line_stride + c], for rows x cols cells. Cells outside 
+      // the raster have values as well. Fields that are not 
+      // pixel_addressable() are only asked for windows that start at the 
+      // corner of a block and are not larger than a block.
+      virtual void generate(int first_row, int first_col, int rows, int cols, double* values,
+        std::ptrdiff_t line_stride) const = 0;
+
+      // True if generating a single cell costs no more than its share of a
+      // block, so that windows and sampled cells can be generated on their
+      // own.
+      virtual bool pixel_addressable() const = 0;
+
+      // Distribution of the value of a cell, the same for every cell.
+      virtual const value_distribution& get_value_distribution() const = 0;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,51 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// splitmix64 (Steele, Lea and Flood 2014). Used to expand a single seed into
+// engine state and to mix seeds with stream and block indices, so that
+// consecutive indices do not produce correlated engine states.
+
+#pragma once
+
+#include <cstdint>
+
+namespace pronto {
+  namespace raster {
+
+    class splitmix64
+    {
+    public:
+      using result_type = uint64_t;
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~result_type(0); }
+
+      explicit splitmix64(uint64_t seed = 0) : m_state(seed)
+      {
+      }
+
+      result_type operator()()
+      {
+        m_state += 0x9E3779B97F4A7C15ull;
+        return mix(m_state);
+      }
+
+      // The stateless finaliser, a bijection on 64-bit integers.
+      static uint64_t mix(uint64_t z)
+      {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+      }
+
+    private:
+      uint64_t m_state;
+    };
+
+  } // namespace raster
+} // namespace pronto
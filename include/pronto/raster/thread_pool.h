@@ -0,0 +1,74 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Pool of worker threads that generates the blocks of large reads in 
+// parallel. 
+//
+// The tasks of a parallel_for are divided into one contiguous range per 
+// thread. A thread takes tasks from the front of its own range and, when
+// that is exhausted, steals tasks from the back of the ranges of the other
+// threads. This keeps neighbouring blocks on the same thread, while blocks
+// that take longer (e.g. with rejection sampling) are balanced out.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    class thread_pool
+    {
+    public:
+      // The calling thread takes part in the work, so num_threads - 1 
+      // workers are started.
+      explicit thread_pool(int num_threads);
+      ~thread_pool();
+
+      thread_pool(const thread_pool&) = delete;
+      thread_pool& operator=(const thread_pool&) = delete;
+
+      int num_threads() const;
+
+      // Calls task(i) for every i in [0, count) and returns when all calls
+      // have completed. The tasks must not throw.
+      void parallel_for(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    private:
+      struct task_range
+      {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+      };
+
+      void worker_loop(std::size_t participant);
+      void work(std::size_t participant);
+      bool next_task(std::size_t participant, std::size_t& index);
+
+      std::vector<std::thread> m_workers;
+      std::unique_ptr<task_range[]> m_ranges;
+
+      std::mutex m_call_mutex; // one parallel_for at a time
+      std::mutex m_mutex;
+      std::condition_variable m_start;
+      std::condition_variable m_done;
+      const std::function<void(std::size_t)>* m_task = nullptr;
+      std::size_t m_generation = 0;
+      std::size_t m_busy_workers = 0;
+      bool m_stop = false;
+    };
+
+  } // namespace raster
+} // namespace pronto
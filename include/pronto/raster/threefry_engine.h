@@ -0,0 +1,112 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Threefry4x64-20 counter-based random engine (Salmon et al. 2011). Like
+// philox4x64_engine the output is a pure function of key and counter, but it
+// only uses additions, rotations and xors, which makes it the faster choice
+// on hardware without a fast 64-bit multiply.
+//
+// The first three counter words identify the stream, the fourth word counts
+// the 4-word output blocks within the stream.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace pronto {
+  namespace raster {
+
+    class threefry4x64_engine
+    {
+    public:
+      using result_type = uint64_t;
+      using counter_type = std::array<uint64_t, 4>;
+      using key_type = std::array<uint64_t, 4>;
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~result_type(0); }
+
+      explicit threefry4x64_engine(uint64_t key0 = 0, uint64_t key1 = 0,
+        uint64_t counter0 = 0, uint64_t counter1 = 0, uint64_t counter2 = 0)
+        : m_key{ key0, key1, 0, 0 }
+        , m_counter{ counter0, counter1, counter2, 0 }
+        , m_output{}
+        , m_index(4)
+      {
+      }
+
+      result_type operator()()
+      {
+        if (m_index == 4) {
+          m_output = generate(m_counter, m_key);
+          ++m_counter[3];
+          m_index = 0;
+        }
+        return m_output[m_index++];
+      }
+
+      void discard(unsigned long long n)
+      {
+        while (n > 0 && m_index < 4) {
+          ++m_index;
+          --n;
+        }
+        m_counter[3] += n / 4;
+        for (n %= 4; n > 0; --n) {
+          operator()();
+        }
+      }
+
+      // The stateless bijection at the heart of the engine.
+      static counter_type generate(const counter_type& counter, const key_type& key)
+      {
+        static constexpr int rotations[8][2] = {
+          {14, 16}, {52, 57}, {23, 40}, {5, 37}, {25, 33}, {46, 12}, {58, 22}, {32, 32}
+        };
+        const uint64_t schedule[5] = { key[0], key[1], key[2], key[3],
+          0x1BD11BDAA9FC1A22ull ^ key[0] ^ key[1] ^ key[2] ^ key[3] };
+
+        counter_type x = { counter[0] + schedule[0], counter[1] + schedule[1],
+          counter[2] + schedule[2], counter[3] + schedule[3] };
+
+        for (int round = 0; round < 20; ++round) {
+          const int* r = rotations[round % 8];
+          if (round % 2 == 0) {
+            x[0] += x[1]; x[1] = rotl(x[1], r[0]); x[1] ^= x[0];
+            x[2] += x[3]; x[3] = rotl(x[3], r[1]); x[3] ^= x[2];
+          }
+          else {
+            x[0] += x[3]; x[3] = rotl(x[3], r[0]); x[3] ^= x[0];
+            x[2] += x[1]; x[1] = rotl(x[1], r[1]); x[1] ^= x[2];
+          }
+          if (round % 4 == 3) {
+            const int s = round / 4 + 1;
+            for (int i = 0; i < 4; ++i) {
+              x[i] += schedule[(s + i) % 5];
+            }
+            x[3] += static_cast<uint64_t>(s);
+          }
+        }
+        return x;
+      }
+
+    private:
+      static uint64_t rotl(uint64_t x, int r)
+      {
+        return (x << r) | (x >> (64 - r));
+      }
+
+      key_type m_key;
+      counter_type m_counter;
+      counter_type m_output;
+      int m_index;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,238 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Batched sampler for std::uniform_int_distribution. Ranges of up to 2^32
+// values use the vectorized Lemire kernel from simd_kernels, followed by
+// a scalar pass over the (rare) rejected values. Wider ranges use the
+// scalar 64-bit version of Lemire's method.
+//
+// Narrow ranges do not need all 64 bits of a draw: each draw is sliced into
+// eight 8-bit or four 16-bit values when the range is small enough for the
+// rejection rate of the narrower multiply-shift to stay below 1/16.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/simd_kernels.h>
+#include <pronto/raster/wide_multiply.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace pronto {
+  namespace raster {
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::uniform_int_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::uniform_int_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_min(static_cast<uint64_t>(distribution.a()))
+        // Wraps around to 0 for the full 64-bit range
+        , m_range(static_cast<uint64_t>(distribution.b()) - m_min + 1)
+        , m_threshold(0)
+        , m_slice_bits(64)
+      {
+        if (m_range != 0 && m_range < (uint64_t(1) << 32)) {
+          const uint32_t range = static_cast<uint32_t>(m_range);
+          m_threshold = static_cast<uint32_t>(0u - range) % range;
+        }
+        if (m_range != 0 && m_range <= (uint64_t(1) << 32)) {
+          m_slice_bits = 32;
+        }
+        for (const int bits : { 16, 8 }) {
+          const uint32_t slice_range = uint32_t(1) << bits;
+          if (m_range != 0 && m_range <= slice_range) {
+            const uint32_t threshold = (slice_range - static_cast<uint32_t>(m_range)) 
+              % static_cast<uint32_t>(m_range);
+            if (threshold * 16 <= slice_range) {
+              m_threshold = threshold;
+              m_slice_bits = bits;
+            }
+          }
+        }
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        if (m_slice_bits == 64) {
+          fill_wide(rng, first, last);
+          return;
+        }
+        if (m_slice_bits == 16) {
+          fill_sliced<uint16_t>(rng, first, last, get_simd_kernels().bits_to_offsets16);
+          return;
+        }
+        if (m_slice_bits == 8) {
+          fill_sliced<uint8_t>(rng, first, last, get_simd_kernels().bits_to_offsets8);
+          return;
+        }
+        const simd_kernels& kernels = get_simd_kernels();
+        const uint32_t range = static_cast<uint32_t>(m_range); // 0 for 2^32
+
+        uint64_t bits[sampler_chunk_size];
+        uint32_t offsets[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_bits(rng, bits, bits + n);
+
+          if (range == 0) {
+            for (std::size_t i = 0; i < n; ++i) {
+              offsets[i] = static_cast<uint32_t>(bits[i] >> 32);
+            }
+          }
+          else if (kernels.bits_to_offsets(bits, offsets, n, range, m_threshold) > 0) {
+            for (std::size_t i = 0; i < n; ++i) {
+              uint64_t product = (bits[i] >> 32) * range;
+              while (static_cast<uint32_t>(product) < m_threshold) {
+                product = (rng() >> 32) * range;
+              }
+              offsets[i] = static_cast<uint32_t>(product >> 32);
+            }
+          }
+
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(m_min + offsets[i]);
+          }
+          first += n;
+        }
+      }
+
+      template<class EngineOf>
+      void fill_streams(const uint64_t* first_draws, EngineOf engine_of, TargetGdalType* out, std::size_t n) const
+      {
+        if (m_slice_bits == 64) {
+          for (std::size_t i = 0; i < n; ++i) {
+            auto rng = engine_of(i);
+            fill_wide(rng, out + i, out + i + 1);
+          }
+          return;
+        }
+
+        // A single value is taken from the high slice of a draw, which for
+        // all slice sizes is the multiply-shift of the kernels.
+        const unsigned shift = 64 - m_slice_bits;
+        const uint64_t low_mask = (uint64_t(1) << m_slice_bits) - 1;
+        for (std::size_t i = 0; i < n; ++i) {
+          uint64_t product = (first_draws[i] >> shift) * m_range;
+          if ((product & low_mask) < m_threshold) {
+            auto rng = engine_of(i);
+            rng(); // first_draws[i]
+            do {
+              product = (rng() >> shift) * m_range;
+            } while ((product & low_mask) < m_threshold);
+          }
+          out[i] = static_cast<TargetGdalType>(m_min + (product >> m_slice_bits));
+        }
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      // Fills using Offset-sized slices of each draw, Offset is uint8_t or 
+      // uint16_t.
+      template<typename Offset, class Generator, class Kernel>
+      void fill_sliced(Generator& rng, TargetGdalType* first, TargetGdalType* last,
+        Kernel kernel) const
+      {
+        constexpr unsigned slice_bits = 8 * sizeof(Offset);
+        constexpr std::size_t slices_per_draw = 64 / slice_bits;
+        const uint32_t range = static_cast<uint32_t>(m_range);
+
+        uint64_t bits[sampler_chunk_size / slices_per_draw];
+        Offset offsets[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          const std::size_t words = (n + slices_per_draw - 1) / slices_per_draw;
+          fill_bits(rng, bits, bits + words);
+
+          if (kernel(bits, offsets, n, range, m_threshold) > 0) {
+            // The kernel marks rejected values with the all-ones sentinel.
+            // Rejections are rare, so look for them a word at a time.
+            std::size_t i = 0;
+            for (; i + slices_per_draw <= n; i += slices_per_draw) {
+              uint64_t word;
+              std::memcpy(&word, offsets + i, sizeof(word));
+              if (has_sentinel<Offset>(word)) {
+                redraw_rejected<Offset>(rng, offsets + i, offsets + i + slices_per_draw, range);
+              }
+            }
+            redraw_rejected<Offset>(rng, offsets + i, offsets + n, range);
+          }
+
+          for (std::size_t i = 0; i < n; ++i) {
+            first[i] = static_cast<TargetGdalType>(m_min + offsets[i]);
+          }
+          first += n;
+        }
+      }
+
+      // True if any of the Offset-sized lanes of word is all ones.
+      template<typename Offset>
+      static bool has_sentinel(uint64_t word)
+      {
+        constexpr uint64_t low_bits = ~uint64_t(0) / ((uint64_t(1) << (8 * sizeof(Offset))) - 1);
+        constexpr uint64_t high_bits = low_bits << (8 * sizeof(Offset) - 1);
+        const uint64_t inverted = ~word; // all-ones lanes become zero lanes
+        return ((inverted - low_bits) & ~inverted & high_bits) != 0;
+      }
+
+      template<typename Offset, class Generator>
+      void redraw_rejected(Generator& rng, Offset* first, Offset* last, uint32_t range) const
+      {
+        constexpr unsigned slice_bits = 8 * sizeof(Offset);
+        constexpr uint32_t mask = (uint32_t(1) << slice_bits) - 1;
+        for (; first != last; ++first) {
+          if (*first != mask) continue;
+          uint32_t product;
+          do {
+            product = static_cast<uint32_t>(rng() >> (64 - slice_bits)) * range;
+          } while ((product & mask) < m_threshold);
+          *first = static_cast<Offset>(product >> slice_bits);
+        }
+      }
+
+      template<class Generator>
+      void fill_wide(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        if (m_range == 0) {
+          for (; first != last; ++first) {
+            *first = static_cast<TargetGdalType>(rng());
+          }
+          return;
+        }
+        const uint64_t threshold = (0 - m_range) % m_range;
+        for (; first != last; ++first) {
+          uint64_t offset;
+          uint64_t low = mul_hi_lo(rng(), m_range, offset);
+          while (low < threshold) {
+            low = mul_hi_lo(rng(), m_range, offset);
+          }
+          *first = static_cast<TargetGdalType>(m_min + offset);
+        }
+      }
+
+      distribution_type m_distribution;
+      uint64_t m_min;
+      uint64_t m_range;
+      uint32_t m_threshold;
+      int m_slice_bits; // 8, 16, 32 or 64
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,109 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Batched sampler for std::uniform_real_distribution, using the vectorized
+// kernels from simd_kernels to write straight into the block. Float32 only
+// needs 23 random bits per value, so each 64-bit draw gives two values.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/simd_kernels.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace pronto {
+  namespace raster {
+
+    template<typename DistributionType, typename TargetGdalType>
+    class block_sampler<std::uniform_real_distribution<DistributionType>, TargetGdalType>
+    {
+    public:
+      using distribution_type = std::uniform_real_distribution<DistributionType>;
+
+      explicit block_sampler(const distribution_type& distribution)
+        : m_distribution(distribution)
+        , m_offset(static_cast<TargetGdalType>(distribution.a()))
+        , m_scale(static_cast<TargetGdalType>(distribution.b() - distribution.a()))
+      {
+      }
+
+      template<class Generator>
+      void fill(Generator& rng, TargetGdalType* first, TargetGdalType* last) const
+      {
+        const simd_kernels& kernels = get_simd_kernels();
+        uint64_t bits[sampler_chunk_size];
+        while (first != last) {
+          const std::size_t n = std::min<std::size_t>(last - first, sampler_chunk_size);
+          fill_bits(rng, bits, bits + words_needed(first, n));
+          convert(kernels, bits, first, n);
+          first += n;
+        }
+      }
+
+      template<class EngineOf>
+      void fill_streams(const uint64_t* first_draws, EngineOf, TargetGdalType* out, std::size_t n) const
+      {
+        convert_streams(get_simd_kernels(), first_draws, out, n);
+      }
+
+      const distribution_type& distribution() const
+      {
+        return m_distribution;
+      }
+
+    private:
+      static std::size_t words_needed(const float*, std::size_t n)
+      {
+        return (n + 1) / 2;
+      }
+
+      static std::size_t words_needed(const double*, std::size_t n)
+      {
+        return n;
+      }
+
+      void convert(const simd_kernels& kernels, const uint64_t* bits, float* out, std::size_t n) const
+      {
+        kernels.bits_to_float(bits, out, n, m_offset, m_scale);
+      }
+
+      void convert(const simd_kernels& kernels, const uint64_t* bits, double* out, std::size_t n) const
+      {
+        kernels.bits_to_double(bits, out, n, m_offset, m_scale);
+      }
+
+      // A single float is taken from the high half of a word, so the first
+      // draws are packed two to a word for the kernel.
+      void convert_streams(const simd_kernels& kernels, const uint64_t* first_draws, float* out,
+        std::size_t n) const
+      {
+        uint64_t bits[(sampler_chunk_size + 1) / 2];
+        for (std::size_t j = 0; 2 * j < n; ++j) {
+          const uint64_t low = 2 * j + 1 < n ? first_draws[2 * j + 1] >> 32 : 0;
+          bits[j] = (first_draws[2 * j] & 0xFFFFFFFF00000000ull) | low;
+        }
+        kernels.bits_to_float(bits, out, n, m_offset, m_scale);
+      }
+
+      void convert_streams(const simd_kernels& kernels, const uint64_t* first_draws, double* out,
+        std::size_t n) const
+      {
+        kernels.bits_to_double(first_draws, out, n, m_offset, m_scale);
+      }
+
+      distribution_type m_distribution;
+      TargetGdalType m_offset;
+      TargetGdalType m_scale;
+    };
+
+  } // namespace raster
+} // namespace pronto
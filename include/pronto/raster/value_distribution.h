@@ -0,0 +1,78 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Distribution of the values as they are stored in a raster band, i.e.
+// after sampling and conversion to the data type of the band. It provides
+// the statistics and histograms of a band without generating any values.
+//
+// The histograms hold the expected number of values in each bucket, rounded
+// such that the buckets add up to the expected number of values in range.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace pronto {
+  namespace raster {
+
+    class value_distribution
+    {
+    public:
+      // Unknown distribution, for which available() is false.
+      value_distribution() = default;
+
+      // cdf(x) is the probability of a value <= x, [lower, upper] is the
+      // support, where an infinite bound means that the support is
+      // unbounded on that side. The mean and variance are NaN when they are
+      // not defined and the variance is infinite when it is not finite.
+      // integer indicates that all values are integers.
+      value_distribution(std::function<double(double)> cdf, double lower, double upper,
+        double mean, double variance, bool integer);
+
+      bool available() const;
+
+      // True if the mean and standard deviation are finite.
+      bool has_moments() const;
+
+      // True if all values are integers.
+      bool integer() const;
+
+      double lower() const;
+      double upper() const;
+      double mean() const;
+      double std_dev() const;
+
+      // Probability of a value < x.
+      double probability_below(double x) const;
+
+      // Smallest value with a probability of at least p of a value <= it.
+      double quantile(double p) const;
+
+      // The bounds of the support or, where it is unbounded, the quantile
+      // that the extreme of count values is expected to exceed.
+      double expected_min(uint64_t count) const;
+      double expected_max(uint64_t count) const;
+
+      // Expected number of the count values in each of buckets equal
+      // intervals of [min, max). Values outside the range are counted in
+      // the first and last bucket if include_out_of_range.
+      void histogram(double min, double max, int buckets, bool include_out_of_range,
+        uint64_t count, uint64_t* counts) const;
+
+    private:
+      std::function<double(double)> m_cdf;
+      double m_lower = 0.0;
+      double m_upper = 0.0;
+      double m_mean = 0.0;
+      double m_variance = 0.0;
+      bool m_integer = false;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,66 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Categorical Voronoi patches. The raster is divided into a grid of square
+// cells of cell_size x cell_size, each holding one seed point at a 
+// jittered position, with a class drawn from the discrete weights. Every 
+// cell of the raster takes the class of the nearest seed point.
+//
+// The seed points and classes are hashed from the position of their grid
+// cell, so each value is a pure function of its position. As a seed point
+// lies within its own grid cell, the nearest seed point is always in one of
+// the 21 grid cells that are at most two grid cells away, excluding the 
+// corners of that 5 x 5 neighbourhood.
+
+#pragma once
+
+#include <pronto/raster/spatial_field.h>
+#include <pronto/raster/value_distribution.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pronto {
+  namespace raster {
+
+    class voronoi_field : public spatial_field
+    {
+    public:
+      // The class of a seed point is i with a probability proportional to 
+      // weights[i]. jitter in [0, 1] is the range of the seed point within
+      // its grid cell, 0 puts it at the centre, which gives a square grid.
+      voronoi_field(uint64_t seed, uint64_t stream, const std::vector<double>& weights,
+        double cell_size, double jitter);
+
+      void generate(int first_row, int first_col, int rows, int cols, double* values,
+        std::ptrdiff_t line_stride) const override;
+
+      bool pixel_addressable() const override;
+
+      const value_distribution& get_value_distribution() const override;
+
+    private:
+      struct seed_point
+      {
+        double row; // in cells of the raster
+        double col;
+        double value;
+      };
+
+      seed_point point_of(int64_t grid_row, int64_t grid_col) const;
+
+      uint64_t m_key;
+      double m_cell_size;
+      double m_jitter;
+      std::vector<double> m_cumulative; // cumulative probabilities of the classes
+      value_distribution m_values;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,59 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Full 64 x 64 -> 128 bit multiplication, used by the counter-based and
+// PCG random engines and by the unbiased integer range reduction. Uses the
+// compiler intrinsic where available and a portable fallback otherwise.
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace pronto {
+  namespace raster {
+
+    // Returns the low 64 bits of a * b and stores the high 64 bits in hi.
+    inline uint64_t mul_hi_lo(uint64_t a, uint64_t b, uint64_t& hi)
+    {
+#if defined(__SIZEOF_INT128__)
+      const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+      hi = static_cast<uint64_t>(product >> 64);
+      return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+      return _umul128(a, b, &hi);
+#else
+      const uint64_t a_lo = a & 0xFFFFFFFFu;
+      const uint64_t a_hi = a >> 32;
+      const uint64_t b_lo = b & 0xFFFFFFFFu;
+      const uint64_t b_hi = b >> 32;
+
+      const uint64_t lo_lo = a_lo * b_lo;
+      const uint64_t hi_lo = a_hi * b_lo;
+      const uint64_t lo_hi = a_lo * b_hi;
+      const uint64_t hi_hi = a_hi * b_hi;
+
+      const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+      hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+      return (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+#endif
+    }
+
+    // Returns the high 64 bits of a * b.
+    inline uint64_t mul_hi(uint64_t a, uint64_t b)
+    {
+      uint64_t hi;
+      mul_hi_lo(a, b, hi);
+      return hi;
+    }
+
+  } // namespace raster
+} // namespace pronto
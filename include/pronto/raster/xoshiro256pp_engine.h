@@ -0,0 +1,70 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// xoshiro256++ random engine (Blackman and Vigna 2019). A fast general
+// purpose engine with a 256-bit state that is filled from the seed by
+// splitmix64, so seeding costs four hash evaluations rather than the 312-word
+// initialisation loop of std::mt19937_64.
+
+#pragma once
+
+#include <pronto/raster/splitmix64.h>
+
+#include <array>
+#include <cstdint>
+
+namespace pronto {
+  namespace raster {
+
+    class xoshiro256pp_engine
+    {
+    public:
+      using result_type = uint64_t;
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~result_type(0); }
+
+      explicit xoshiro256pp_engine(uint64_t seed = 0)
+      {
+        splitmix64 init(seed);
+        for (auto& s : m_state) {
+          s = init();
+        }
+      }
+
+      result_type operator()()
+      {
+        const uint64_t result = rotl(m_state[0] + m_state[3], 23) + m_state[0];
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+      }
+
+      void discard(unsigned long long n)
+      {
+        for (; n > 0; --n) {
+          operator()();
+        }
+      }
+
+    private:
+      static uint64_t rotl(uint64_t x, int r)
+      {
+        return (x << r) | (x >> (64 - r));
+      }
+
+      std::array<uint64_t, 4> m_state;
+    };
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,157 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Ziggurat method for standard normal variates (Marsaglia and Tsang 2000),
+// using 256 layers and a single 64-bit draw per attempt: the low 8 bits
+// select the layer and the high 52 bits give a uniform value in [-1, 1).
+//
+// The fast path, which accepts about 99% of the attempts, is a table lookup
+// and a comparison and is evaluated for whole chunks by the SIMD kernels.
+// ziggurat_normal_complete handles the attempts rejected by the fast path.
+
+#pragma once
+
+#include <pronto/raster/block_sampler.h>
+#include <pronto/raster/simd_kernels.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace pronto {
+  namespace raster {
+
+    class ziggurat_normal_table
+    {
+    public:
+      static constexpr int layers = 256;
+
+      // Right-hand edge of the base layer and the area of each layer.
+      static constexpr double r = 3.6541528853610088;
+      static constexpr double v = 0.00492867323399;
+
+      static const ziggurat_normal_table& get()
+      {
+        static const ziggurat_normal_table table;
+        return table;
+      }
+
+      // Layer edges, decreasing from x[0] = v / f(r) to x[layers] = 0.
+      std::array<double, layers + 1> x;
+
+      // Density (without normalising constant) at the layer edges.
+      std::array<double, layers + 1> f;
+
+    private:
+      ziggurat_normal_table()
+      {
+        x[0] = v / density(r);
+        x[1] = r;
+        for (int i = 2; i < layers; ++i) {
+          x[i] = std::sqrt(-2.0 * std::log(v / x[i - 1] + density(x[i - 1])));
+        }
+        x[layers] = 0.0;
+        for (int i = 0; i <= layers; ++i) {
+          f[i] = density(x[i]);
+        }
+      }
+
+      static double density(double x)
+      {
+        return std::exp(-0.5 * x * x);
+      }
+    };
+
+    // Uniform value in [-1, 1) from the 52 high bits.
+    inline double ziggurat_signed_uniform(uint64_t bits)
+    {
+      const uint64_t pattern = (bits >> 12) | 0x4000000000000000ull; // [2, 4)
+      double two_to_four;
+      std::memcpy(&two_to_four, &pattern, sizeof(double));
+      return two_to_four - 3.0;
+    }
+
+    // Completes a normal variate whose first attempt used the given bits.
+    template<class Generator>
+    double ziggurat_normal_complete(Generator& rng, uint64_t bits,
+      const ziggurat_normal_table& table)
+    {
+      for (;;) {
+        const int layer = static_cast<int>(bits & 0xFF);
+        const double u = ziggurat_signed_uniform(bits);
+        const double x = u * table.x[layer];
+        if (std::abs(x) < table.x[layer + 1]) {
+          return x;
+        }
+        if (layer == 0) {
+          // Sample from the tail beyond r (Marsaglia 1964).
+          double tail_x, tail_y;
+          do {
+            tail_x = -std::log(positive_unit_interval(rng())) / ziggurat_normal_table::r;
+            tail_y = -std::log(positive_unit_interval(rng()));
+          } while (2.0 * tail_y < tail_x * tail_x);
+          return u < 0 ? -(ziggurat_normal_table::r + tail_x) : ziggurat_normal_table::r + tail_x;
+        }
+        const double y = table.f[layer + 1]
+          + (table.f[layer] - table.f[layer + 1]) * positive_unit_interval(rng());
+        if (y < std::exp(-0.5 * x * x)) {
+          return x;
+        }
+        bits = rng();
+      }
+    }
+
+    // Fills out[0, n) with standard normal variates, using bits[0, n) as
+    // scratch space.
+    template<class Generator>
+    void fill_standard_normal(Generator& rng, double* out, std::size_t n, uint64_t* bits)
+    {
+      const ziggurat_normal_table& table = ziggurat_normal_table::get();
+      fill_bits(rng, bits, bits + n);
+      if (get_simd_kernels().bits_to_normal(bits, out, n, table.x.data()) > 0) {
+        for (std::size_t i = 0; i < n; ++i) {
+          const int layer = static_cast<int>(bits[i] & 0xFF);
+          if (!(std::abs(out[i]) < table.x[layer + 1])) {
+            out[i] = ziggurat_normal_complete(rng, bits[i], table);
+          }
+        }
+      }
+    }
+
+    // Fills out[0, n) with standard normal variates, n <= sampler_chunk_size.
+    template<class Generator>
+    void fill_standard_normal(Generator& rng, double* out, std::size_t n)
+    {
+      uint64_t bits[sampler_chunk_size];
+      fill_standard_normal(rng, out, n, bits);
+    }
+
+    // Fills out[0, n) with standard normal variates, out[i] as drawn by
+    // fill_standard_normal from the fresh engine engine_of(i), whose first
+    // output is first_draws[i].
+    template<class EngineOf>
+    void fill_standard_normal_streams(const uint64_t* first_draws, EngineOf& engine_of,
+      double* out, std::size_t n)
+    {
+      const ziggurat_normal_table& table = ziggurat_normal_table::get();
+      if (get_simd_kernels().bits_to_normal(first_draws, out, n, table.x.data()) > 0) {
+        for (std::size_t i = 0; i < n; ++i) {
+          const int layer = static_cast<int>(first_draws[i] & 0xFF);
+          if (!(std::abs(out[i]) < table.x[layer + 1])) {
+            auto rng = engine_of(i);
+            rng(); // first_draws[i]
+            out[i] = ziggurat_normal_complete(rng, first_draws[i], table);
+          }
+        }
+      }
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,67 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/background_workers.h>
+
+#include <utility>
+
+namespace pronto {
+  namespace raster {
+
+    background_workers::background_workers(int num_threads)
+    {
+      for (int i = 0; i < num_threads; ++i) {
+        m_workers.emplace_back(&background_workers::worker_loop, this);
+      }
+    }
+
+    background_workers::~background_workers()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+      m_work.notify_all();
+      for (std::thread& worker : m_workers) {
+        worker.join();
+      }
+    }
+
+    int background_workers::num_threads() const
+    {
+      return static_cast<int>(m_workers.size());
+    }
+
+    void background_workers::submit(std::function<void()> task)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+      }
+      m_work.notify_one();
+    }
+
+    void background_workers::worker_loop()
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (true) {
+        m_work.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+        if (m_tasks.empty()) {
+          return; // stopped
+        }
+        std::function<void()> task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+      }
+    }
+
+  } // namespace raster
+} // namespace pronto
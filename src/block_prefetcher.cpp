@@ -0,0 +1,142 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <cstring>
+
+#include <pronto/raster/block_prefetcher.h>
+
+namespace pronto {
+  namespace raster {
+
+    block_prefetcher::block_prefetcher(block_generator_interface* generator, int blocks_in_row,
+      int blocks_in_column, std::size_t values_in_block, std::size_t bytes_in_block, int depth,
+      background_workers& workers)
+      : m_generator(generator)
+      , m_blocks_in_row(blocks_in_row)
+      , m_block_count(static_cast<int64_t>(blocks_in_row) * blocks_in_column)
+      , m_values_in_block(values_in_block)
+      , m_bytes_in_block(bytes_in_block)
+      , m_depth(depth)
+      , m_workers(workers)
+      , m_slots(static_cast<std::size_t>(depth) + 1)
+    {
+      for (slot& s : m_slots) {
+        s.data.resize(bytes_in_block);
+      }
+    }
+
+    block_prefetcher::~block_prefetcher()
+    {
+      // Tasks that have not started return straight away.
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_stop = true;
+      m_idle.wait(lock, [this] { return m_pending_tasks == 0; });
+    }
+
+    void block_prefetcher::read_block(int major_row, int major_col, void* block)
+    {
+      const int64_t index = static_cast<int64_t>(major_row) * m_blocks_in_row + major_col;
+      bool hit = false;
+      std::unique_lock<std::mutex> lock(m_mutex);
+      const bool sequential = index == m_last_index + 1;
+      m_last_index = index;
+
+      slot& s = m_slots[static_cast<std::size_t>(index % static_cast<int64_t>(m_slots.size()))];
+      if (s.index == index && s.state == slot_state::queued) {
+        s.state = slot_state::empty; // not started, quicker to generate here
+      }
+      else if (s.index == index && s.state != slot_state::empty) {
+        // Another reader may schedule a different block in the slot while 
+        // this one waits, the block is then generated here.
+        m_ready.wait(lock, [&] { return s.index != index || s.state == slot_state::ready; });
+        if (s.index == index) {
+          std::memcpy(block, s.data.data(), m_bytes_in_block);
+          hit = true;
+        }
+      }
+      ++(hit ? m_hits : m_misses);
+
+      int new_tasks = 0;
+      if (sequential) {
+        for (int k = 1; k <= m_depth; ++k) {
+          new_tasks += schedule(index + k) ? 1 : 0;
+        }
+      }
+      m_pending_tasks += new_tasks;
+      lock.unlock();
+      for (int i = 0; i < new_tasks; ++i) {
+        m_workers.submit([this] { run_task(); });
+      }
+
+      if (!hit) {
+        m_generator->fill_block(major_row, major_col, block, m_values_in_block);
+      }
+    }
+
+    uint64_t block_prefetcher::hits() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_hits;
+    }
+
+    uint64_t block_prefetcher::misses() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_misses;
+    }
+
+    // Queues a block for generation, unless it is already in the ring 
+    // buffer or its slot is still being generated. Requires the lock.
+    bool block_prefetcher::schedule(int64_t index)
+    {
+      if (index >= m_block_count) {
+        return false;
+      }
+      const std::size_t slot_index = static_cast<std::size_t>(index % static_cast<int64_t>(m_slots.size()));
+      slot& s = m_slots[slot_index];
+      if ((s.index == index && s.state != slot_state::empty) || s.state == slot_state::generating) {
+        return false;
+      }
+      const bool new_task = s.state != slot_state::queued;
+      if (new_task) {
+        m_queue.push_back(slot_index);
+      }
+      s.index = index;
+      s.state = slot_state::queued;
+      return new_task;
+    }
+
+    // A task is submitted for every entry of the queue, so there is one
+    // to take unless the prefetcher is being destroyed.
+    void block_prefetcher::run_task()
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (!m_stop && !m_queue.empty()) {
+        slot& s = m_slots[m_queue.front()];
+        m_queue.pop_front();
+        if (s.state == slot_state::queued) { // else taken back by read_block
+          s.state = slot_state::generating;
+          const int64_t index = s.index;
+          lock.unlock();
+
+          m_generator->fill_block(static_cast<int>(index / m_blocks_in_row),
+            static_cast<int>(index % m_blocks_in_row), s.data.data(), m_values_in_block);
+
+          lock.lock();
+          s.state = slot_state::ready;
+          m_ready.notify_all();
+        }
+      }
+      if (--m_pending_tasks == 0) {
+        m_idle.notify_all();
+      }
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,100 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/coherent_noise_field.h>
+#include <pronto/raster/simd_kernels.h>
+#include <pronto/raster/splitmix64.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace pronto {
+  namespace raster {
+
+    coherent_noise_field::coherent_noise_field(uint64_t seed, uint64_t stream, int rows, int cols,
+      noise_basis basis, double mean, double amplitude, double scale, int octaves, double lacunarity, double gain)
+      : m_basis(basis)
+      , m_mean(mean)
+      , m_amplitude(amplitude)
+    {
+      // Each octave has its own hash seed and lattice offset, so that the 
+      // lattice points of the octaves do not coincide.
+      uint64_t key = splitmix64::mix(seed ^ splitmix64::mix(stream + 0x434F484552454E54ull));
+      double frequency = 1.0 / scale;
+      double weight = 1.0;
+      double total_weight = 0.0;
+      for (int k = 0; k < octaves; ++k) {
+        key = splitmix64::mix(key);
+        const uint64_t offsets = splitmix64::mix(key ^ 0x9E3779B97F4A7C15ull);
+        octave o;
+        o.seed = static_cast<uint32_t>(key >> 32);
+        o.frequency = frequency;
+        o.weight = weight;
+        o.x_offset = std::ldexp(static_cast<double>(offsets >> 40), -24) * 256.0;
+        o.y_offset = std::ldexp(static_cast<double>(offsets & 0xFFFFFF), -24) * 256.0;
+        m_octaves.push_back(o);
+        total_weight += weight;
+        frequency *= lacunarity;
+        weight *= gain;
+      }
+      for (octave& o : m_octaves) {
+        o.weight /= total_weight;
+      }
+
+      // The lattice coordinates are converted to int32_t.
+      const double extent = static_cast<double>(std::max(rows, cols)) * m_octaves.back().frequency + 512.0;
+      if (!(extent < static_cast<double>(std::numeric_limits<int32_t>::max()))) {
+        throw std::runtime_error("The raster is too large for the lattice of the highest octave, "
+          "reduce 'octaves' or 'lacunarity', or increase 'scale'");
+      }
+    }
+
+    void coherent_noise_field::generate(int first_row, int first_col, int rows, int cols, double* values,
+      std::ptrdiff_t line_stride) const
+    {
+      const simd_kernels& kernels = get_simd_kernels();
+      auto noise = m_basis == noise_basis::perlin ? kernels.perlin_noise : kernels.simplex_noise;
+      std::vector<double> octave_values(m_octaves.size() > 1 ? cols : 0);
+      for (int r = 0; r < rows; ++r) {
+        double* target = values + r * line_stride;
+        const double row_centre = first_row + r + 0.5;
+        const double col_centre = first_col + 0.5;
+        if (m_octaves.size() == 1) {
+          const octave& o = m_octaves.front();
+          noise(col_centre, o.frequency, o.x_offset, row_centre * o.frequency + o.y_offset,
+            cols, o.seed, target);
+        }
+        else {
+          std::fill(target, target + cols, 0.0);
+          for (const octave& o : m_octaves) {
+            noise(col_centre, o.frequency, o.x_offset, row_centre * o.frequency + o.y_offset,
+              cols, o.seed, octave_values.data());
+            kernels.multiply_add(octave_values.data(), cols, o.weight, target);
+          }
+        }
+        for (int c = 0; c < cols; ++c) {
+          target[c] = m_mean + m_amplitude * target[c];
+        }
+      }
+    }
+
+    bool coherent_noise_field::pixel_addressable() const
+    {
+      return true;
+    }
+
+    const value_distribution& coherent_noise_field::get_value_distribution() const
+    {
+      return m_values;
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,165 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/fft.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace pronto {
+  namespace raster {
+
+    fft_plan::fft_plan(std::size_t n)
+      : m_size(n)
+    {
+      if (n == 0) {
+        throw std::runtime_error("The size of a Fourier transform must be positive");
+      }
+      std::size_t remainder = n;
+      for (std::size_t p : { 5, 3, 2 }) {
+        while (remainder % p == 0) {
+          m_factors.push_back(p);
+          remainder /= p;
+        }
+      }
+      if (remainder != 1) {
+        throw std::runtime_error("The size of a Fourier transform must only have the prime factors 2, 3 and 5");
+      }
+
+      const double pi = 3.14159265358979323846;
+      m_twiddles.resize(n);
+      for (std::size_t k = 0; k < n; ++k) {
+        const double angle = -2.0 * pi * static_cast<double>(k) / static_cast<double>(n);
+        m_twiddles[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+      }
+    }
+
+    std::size_t fft_plan::size() const
+    {
+      return m_size;
+    }
+
+    std::size_t fft_plan::next_size(std::size_t n)
+    {
+      for (std::size_t candidate = std::max<std::size_t>(n, 1);; ++candidate) {
+        std::size_t remainder = candidate;
+        for (std::size_t p : { 2, 3, 5 }) {
+          while (remainder % p == 0) {
+            remainder /= p;
+          }
+        }
+        if (remainder == 1) {
+          return candidate;
+        }
+      }
+    }
+
+    // Decimation in time: the n values are split into p interleaved
+    // sequences of m = n / p values, which are transformed recursively into
+    // consecutive parts of out and then combined.
+    void fft_plan::transform(const std::complex<double>* in, std::ptrdiff_t stride, std::complex<double>* out,
+      std::size_t n, std::size_t factor_index) const
+    {
+      if (n == 1) {
+        out[0] = in[0];
+        return;
+      }
+      const std::size_t p = m_factors[factor_index];
+      const std::size_t m = n / p;
+      for (std::size_t q = 0; q < p; ++q) {
+        transform(in + q * stride, stride * static_cast<std::ptrdiff_t>(p), out + q * m, m, factor_index + 1);
+      }
+
+      const std::size_t twiddle_step = m_size / n;
+      std::complex<double> terms[5];
+      for (std::size_t k = 0; k < m; ++k) {
+        for (std::size_t q = 0; q < p; ++q) {
+          terms[q] = out[q * m + k] * m_twiddles[q * k * twiddle_step];
+        }
+        for (std::size_t s = 0; s < p; ++s) {
+          std::complex<double> sum = terms[0];
+          for (std::size_t q = 1; q < p; ++q) {
+            sum += terms[q] * m_twiddles[(q * s * m * twiddle_step) % m_size];
+          }
+          out[s * m + k] = sum;
+        }
+      }
+    }
+
+    void fft_plan::forward(std::complex<double>* x, std::ptrdiff_t stride, std::complex<double>* scratch) const
+    {
+      std::complex<double>* in = scratch;
+      std::complex<double>* out = scratch + m_size;
+      for (std::size_t k = 0; k < m_size; ++k) {
+        in[k] = x[k * stride];
+      }
+      transform(in, 1, out, m_size, 0);
+      for (std::size_t k = 0; k < m_size; ++k) {
+        x[k * stride] = out[k];
+      }
+    }
+
+    void fft_plan::inverse(std::complex<double>* x, std::ptrdiff_t stride, std::complex<double>* scratch) const
+    {
+      std::complex<double>* in = scratch;
+      std::complex<double>* out = scratch + m_size;
+      for (std::size_t k = 0; k < m_size; ++k) {
+        in[k] = std::conj(x[k * stride]);
+      }
+      transform(in, 1, out, m_size, 0);
+      for (std::size_t k = 0; k < m_size; ++k) {
+        x[k * stride] = std::conj(out[k]);
+      }
+    }
+
+    fft_plan_2d::fft_plan_2d(std::size_t rows, std::size_t cols)
+      : m_rows(rows)
+      , m_cols(cols)
+    {
+    }
+
+    std::size_t fft_plan_2d::rows() const
+    {
+      return m_rows.size();
+    }
+
+    std::size_t fft_plan_2d::cols() const
+    {
+      return m_cols.size();
+    }
+
+    void fft_plan_2d::forward(std::complex<double>* x) const
+    {
+      const std::size_t rows = m_rows.size();
+      const std::size_t cols = m_cols.size();
+      std::vector<std::complex<double>> scratch(2 * std::max(rows, cols));
+      for (std::size_t r = 0; r < rows; ++r) {
+        m_cols.forward(x + r * cols, 1, scratch.data());
+      }
+      for (std::size_t c = 0; c < cols; ++c) {
+        m_rows.forward(x + c, static_cast<std::ptrdiff_t>(cols), scratch.data());
+      }
+    }
+
+    void fft_plan_2d::inverse(std::complex<double>* x) const
+    {
+      const std::size_t rows = m_rows.size();
+      const std::size_t cols = m_cols.size();
+      std::vector<std::complex<double>> scratch(2 * std::max(rows, cols));
+      for (std::size_t r = 0; r < rows; ++r) {
+        m_cols.inverse(x + r * cols, 1, scratch.data());
+      }
+      for (std::size_t c = 0; c < cols; ++c) {
+        m_rows.inverse(x + c, static_cast<std::ptrdiff_t>(cols), scratch.data());
+      }
+    }
+
+  } // namespace raster
+} // namespace pronto
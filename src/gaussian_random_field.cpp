@@ -0,0 +1,260 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/continuous_cdf.h>
+#include <pronto/raster/gaussian_random_field.h>
+#include <pronto/raster/splitmix64.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace pronto {
+  namespace raster {
+
+    namespace {
+      const double pi = 3.14159265358979323846;
+
+      // Share of the squared mass of the kernel that is cut off.
+      const double kernel_tolerance = 1e-4;
+
+      // The distance over which the covariance decays, relative to the 
+      // correlation length.
+      double decay_scale(covariance_model covariance, double nu)
+      {
+        return covariance == covariance_model::matern ? 1.0 / std::min(1.0, std::sqrt(2.0 * nu)) : 1.0;
+      }
+
+      // Logarithm of the modified Bessel function of the second kind, as 
+      // std::cyl_bessel_k is not available in all standard libraries. The 
+      // integral K_nu(x) = int_0^inf exp(-x cosh t) cosh(nu t) dt is taken
+      // by the trapezoidal rule, which converges exponentially fast for it,
+      // relative to its peak so that it does not overflow for large nu.
+      double log_bessel_k(double nu, double x)
+      {
+        const double peak = std::asinh(nu / x);
+        const double top = nu * peak - x * std::cosh(peak);
+        const double step = std::min(0.125, 0.25 / std::sqrt(std::sqrt(x * x + nu * nu)));
+        double sum = 0.0;
+        for (int i = 0; ; ++i) {
+          const double t = i * step;
+          const double e = -x * std::cosh(t) - top;
+          const double term = 0.5 * (std::exp(nu * t + e) + std::exp(-nu * t + e));
+          sum += i == 0 ? 0.5 * term : term;
+          if (t > peak && term < 1e-17 * sum) break;
+        }
+        return top + std::log(step * sum);
+      }
+
+      double covariance_at(covariance_model covariance, double length, double nu, double h)
+      {
+        switch (covariance) {
+        case covariance_model::exponential:
+          return std::exp(-h / length);
+        case covariance_model::gaussian:
+          return std::exp(-(h / length) * (h / length));
+        default: {
+          if (h == 0.0) return 1.0;
+          const double x = std::sqrt(2.0 * nu) * h / length;
+          if (x > 700.0) return 0.0;
+          return std::exp((1.0 - nu) * std::log(2.0) - std::lgamma(nu) + nu * std::log(x) + log_bessel_k(nu, x));
+        }
+        }
+      }
+
+      // The kernel on [-radius, radius]^2, in row major order, with a 
+      // squared sum of one.
+      std::vector<double> make_kernel(covariance_model covariance, double length, double nu, int& radius)
+      {
+        // Circulant embedding on a grid of size M, the covariance is 
+        // negligible at distance M / 2.
+        const double scale = length * decay_scale(covariance, nu);
+        const std::size_t m = fft_plan::next_size(std::max<std::size_t>(64, 
+          static_cast<std::size_t>(std::ceil(16.0 * scale))));
+        fft_plan_2d plan(m, m);
+
+        // The covariance is symmetric in the offsets, so it is evaluated
+        // for di <= dj only.
+        const std::size_t half = m / 2 + 1;
+        std::vector<double> offsets(half * half);
+        for (std::size_t di = 0; di < half; ++di) {
+          for (std::size_t dj = di; dj < half; ++dj) {
+            offsets[di * half + dj] = covariance_at(covariance, length, nu,
+              std::hypot(static_cast<double>(di), static_cast<double>(dj)));
+            offsets[dj * half + di] = offsets[di * half + dj];
+          }
+        }
+        std::vector<std::complex<double>> grid(m * m);
+        for (std::size_t i = 0; i < m; ++i) {
+          const std::size_t di = std::min(i, m - i);
+          for (std::size_t j = 0; j < m; ++j) {
+            grid[i * m + j] = offsets[di * half + std::min(j, m - j)];
+          }
+        }
+
+        // The square root of the spectral density, negative values are
+        // rounding errors of the embedding.
+        plan.forward(grid.data());
+        for (std::complex<double>& value : grid) {
+          value = std::sqrt(std::max(0.0, value.real()));
+        }
+        plan.inverse(grid.data());
+        auto at = [&](int di, int dj) {
+          const std::size_t i = static_cast<std::size_t>((di + static_cast<int>(m)) % static_cast<int>(m));
+          const std::size_t j = static_cast<std::size_t>((dj + static_cast<int>(m)) % static_cast<int>(m));
+          return grid[i * m + j].real();
+          };
+
+        // Grows the kernel ring by ring until it holds all but the 
+        // tolerance of the squared mass.
+        double total = 0.0;
+        for (const std::complex<double>& value : grid) {
+          total += value.real() * value.real();
+        }
+        const int max_radius = static_cast<int>(m / 2) - 1;
+        double mass = at(0, 0) * at(0, 0);
+        radius = 0;
+        while (radius < max_radius && mass < (1.0 - kernel_tolerance) * total) {
+          ++radius;
+          for (int d = -radius; d <= radius; ++d) {
+            mass += at(-radius, d) * at(-radius, d) + at(radius, d) * at(radius, d);
+            if (d != -radius && d != radius) {
+              mass += at(d, -radius) * at(d, -radius) + at(d, radius) * at(d, radius);
+            }
+          }
+        }
+
+        const int width = 2 * radius + 1;
+        std::vector<double> kernel(static_cast<std::size_t>(width) * width);
+        for (int di = -radius; di <= radius; ++di) {
+          for (int dj = -radius; dj <= radius; ++dj) {
+            kernel[static_cast<std::size_t>(di + radius) * width + (dj + radius)] = at(di, dj);
+          }
+        }
+        double sum_squares = 0.0;
+        for (double k : kernel) {
+          sum_squares += k * k;
+        }
+        const double normalize = 1.0 / std::sqrt(sum_squares);
+        for (double& k : kernel) {
+          k *= normalize;
+        }
+        return kernel;
+      }
+    } // namespace
+
+    gaussian_random_field::gaussian_random_field(uint64_t seed, uint64_t stream, int block_rows, int block_cols,
+      double mean, double stddev, covariance_model covariance, double correlation_length, double nu)
+      : m_key(splitmix64::mix(seed ^ splitmix64::mix(stream + 0x4752465F4E4F4953ull)))
+      , m_mean(mean)
+      , m_stddev(stddev)
+      , m_radius(0)
+      , m_block_rows(block_rows)
+      , m_block_cols(block_cols)
+      , m_tile_plan(1, 1)
+    {
+      // The halo of a block grows with the correlation length, it is kept
+      // in proportion to the block.
+      const double scaled_length = correlation_length * decay_scale(covariance, nu);
+      if (!(correlation_length > 0.0) || !(scaled_length <= max_correlation_length)
+        || !(scaled_length <= std::min(block_rows, block_cols))) {
+        throw std::runtime_error("The correlation length of a gaussian_random_field must be positive and, "
+          "scaled by the decay of the covariance, at most 128 cells and at most the block size");
+      }
+      const std::vector<double> kernel = make_kernel(covariance, correlation_length, nu, m_radius);
+
+      // The tile holds the block and its halo.
+      const std::size_t tile_rows = fft_plan::next_size(static_cast<std::size_t>(block_rows) + 2 * m_radius);
+      const std::size_t tile_cols = fft_plan::next_size(static_cast<std::size_t>(block_cols) + 2 * m_radius);
+      m_tile_plan = fft_plan_2d(tile_rows, tile_cols);
+
+      // The kernel is symmetric, so its transform is real.
+      std::vector<std::complex<double>> tile(tile_rows * tile_cols);
+      const int width = 2 * m_radius + 1;
+      for (int di = -m_radius; di <= m_radius; ++di) {
+        const std::size_t i = static_cast<std::size_t>((di + static_cast<int>(tile_rows)) % static_cast<int>(tile_rows));
+        for (int dj = -m_radius; dj <= m_radius; ++dj) {
+          const std::size_t j = static_cast<std::size_t>((dj + static_cast<int>(tile_cols)) % static_cast<int>(tile_cols));
+          tile[i * tile_cols + j] += kernel[static_cast<std::size_t>(di + m_radius) * width + (dj + m_radius)];
+        }
+      }
+      m_tile_plan.forward(tile.data());
+      const double inverse_scale = 1.0 / static_cast<double>(tile_rows * tile_cols);
+      m_tile_spectrum.resize(tile.size());
+      for (std::size_t k = 0; k < tile.size(); ++k) {
+        m_tile_spectrum[k] = tile[k].real() * inverse_scale;
+      }
+
+      const std::normal_distribution<double> marginal(mean, stddev);
+      auto cdf = [marginal](double x) { return continuous_cdf<std::normal_distribution<double>>::cdf(marginal, x); };
+      m_values = value_distribution(cdf, -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::infinity(), mean, stddev * stddev, false);
+    }
+
+    double gaussian_random_field::noise(int row, int col) const
+    {
+      // Box-Muller on two 53 bit uniforms, u1 in (0, 1].
+      const uint64_t position = (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32)
+        | static_cast<uint32_t>(col);
+      const uint64_t first = splitmix64::mix(m_key + splitmix64::mix(position));
+      const uint64_t second = splitmix64::mix(first + 0x9E3779B97F4A7C15ull);
+      const double u1 = std::ldexp(static_cast<double>((first >> 11) + 1), -53);
+      const double u2 = std::ldexp(static_cast<double>(second >> 11), -53);
+      return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * pi * u2);
+    }
+
+    void gaussian_random_field::generate(int first_row, int first_col, int rows, int cols, double* values,
+      std::ptrdiff_t line_stride) const
+    {
+      const std::size_t tile_rows = m_tile_plan.rows();
+      const std::size_t tile_cols = m_tile_plan.cols();
+      std::vector<std::complex<double>> tile(tile_rows * tile_cols);
+      for (int i = 0; i < rows + 2 * m_radius; ++i) {
+        std::complex<double>* tile_row = tile.data() + static_cast<std::size_t>(i) * tile_cols;
+        for (int j = 0; j < cols + 2 * m_radius; ++j) {
+          tile_row[j] = noise(first_row - m_radius + i, first_col - m_radius + j);
+        }
+      }
+
+      // Circular convolution, which equals the linear convolution away
+      // from the halo.
+      m_tile_plan.forward(tile.data());
+      for (std::size_t k = 0; k < tile.size(); ++k) {
+        tile[k] *= m_tile_spectrum[k];
+      }
+      m_tile_plan.inverse(tile.data());
+
+      for (int r = 0; r < rows; ++r) {
+        const std::complex<double>* tile_row = tile.data() + static_cast<std::size_t>(r + m_radius) * tile_cols + m_radius;
+        for (int c = 0; c < cols; ++c) {
+          values[r * line_stride + c] = m_mean + m_stddev * tile_row[c].real();
+        }
+      }
+    }
+
+    bool gaussian_random_field::pixel_addressable() const
+    {
+      return false;
+    }
+
+    const value_distribution& gaussian_random_field::get_value_distribution() const
+    {
+      return m_values;
+    }
+
+    int gaussian_random_field::kernel_radius() const
+    {
+      return m_radius;
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -5,6 +5,14 @@
 //
 // Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
 //===
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <vector>
+
 #include <pronto/raster/block_generator_interface.h> 
 #include <pronto/raster/random_raster_dataset.h>
 #include <pronto/raster/random_raster_band.h>
@@ -12,6 +20,29 @@
 namespace pronto {
   namespace raster {
 
+    namespace {
+      raster_moments band_moments(GDALDataType data_type, const void* data, int rows, int cols,
+        GSpacing pixel_space, GSpacing line_space, double nodata)
+      {
+        // As stored in the band.
+        if (data_type == GDT_Float32 && std::isfinite(nodata)) {
+          nodata = static_cast<float>(nodata);
+        }
+        switch (data_type) {
+        case GDT_Byte:    return raster_moments::of<std::uint8_t>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_UInt16:  return raster_moments::of<std::uint16_t>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_Int16:   return raster_moments::of<std::int16_t>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_UInt32:  return raster_moments::of<std::uint32_t>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_Int32:   return raster_moments::of<std::int32_t>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_UInt64:  return raster_moments::of<std::uint64_t>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_Int64:   return raster_moments::of<std::int64_t>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_Float32: return raster_moments::of<float>(data, rows, cols, pixel_space, line_space, nodata);
+        case GDT_Float64: return raster_moments::of<double>(data, rows, cols, pixel_space, line_space, nodata);
+        default:          return raster_moments{};
+        }
+      }
+    } // namespace
+
     random_raster_band::random_raster_band(random_raster_dataset* ds, int n_band, block_generator_interface* block_gen,
                                        GDALDataType data_type, int block_rows, int block_cols)
         : m_block_generator(block_gen)
@@ -23,6 +54,46 @@ namespace pronto {
       this->nBlockYSize = block_rows;
     }
 
+    random_raster_band::~random_raster_band()
+    {
+      stop_background_work();
+    }
+
+    void random_raster_band::set_prefetch(int depth, background_workers* workers)
+    {
+      if (m_prefetcher) {
+        CPLDebug("RANDOM_RASTER", "Band %d prefetch hits: " CPL_FRMT_GUIB ", misses: " CPL_FRMT_GUIB,
+          nBand, static_cast<GUIntBig>(m_prefetcher->hits()), static_cast<GUIntBig>(m_prefetcher->misses()));
+        m_prefetcher.reset();
+      }
+      if (depth > 0 && workers != nullptr && m_block_generator != nullptr) {
+        const int blocks_in_row = (nRasterXSize + nBlockXSize - 1) / nBlockXSize;
+        const int blocks_in_column = (nRasterYSize + nBlockYSize - 1) / nBlockYSize;
+        const size_t values_in_block = static_cast<size_t>(nBlockXSize) * nBlockYSize;
+        m_prefetcher = std::make_unique<block_prefetcher>(m_block_generator, blocks_in_row, blocks_in_column,
+          values_in_block, values_in_block * GDALGetDataTypeSizeBytes(eDataType), depth, *workers);
+      }
+    }
+
+    const char* random_raster_band::GetMetadataItem(const char* pszName, const char* pszDomain)
+    {
+      if (pszDomain != nullptr && EQUAL(pszDomain, "PREFETCH") && pszName != nullptr) {
+        const uint64_t hits = m_prefetcher ? m_prefetcher->hits() : 0;
+        const uint64_t misses = m_prefetcher ? m_prefetcher->misses() : 0;
+        if (EQUAL(pszName, "HITS")) {
+          return CPLSPrintf(CPL_FRMT_GUIB, static_cast<GUIntBig>(hits));
+        }
+        if (EQUAL(pszName, "MISSES")) {
+          return CPLSPrintf(CPL_FRMT_GUIB, static_cast<GUIntBig>(misses));
+        }
+        if (EQUAL(pszName, "HIT_RATE")) {
+          return CPLSPrintf("%.4f", hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0);
+        }
+        return nullptr;
+      }
+      return GDALPamRasterBand::GetMetadataItem(pszName, pszDomain);
+    }
+
     CPLErr random_raster_band::IReadBlock(int nBlockXOff, int nBlockYOff, void* p_data)
     {
       if (m_block_generator == nullptr) {
@@ -30,13 +101,547 @@ namespace pronto {
         return CE_Failure;
       }
       int major_row = nBlockYOff; 
-      int major_col = nBlockYOff;
+      int major_col = nBlockXOff;
       const int pixels_in_block = nBlockXSize * nBlockYSize;
-      m_block_generator->fill_block(major_row, major_col, p_data, pixels_in_block);
 
+      // Blocks inside a window announced by AdviseRead are copied from it.
+      const int first_row = major_row * nBlockYSize;
+      const int first_col = major_col * nBlockXSize;
+      const int valid_rows = std::min(nBlockYSize, nRasterYSize - first_row);
+      const int valid_cols = std::min(nBlockXSize, nRasterXSize - first_col);
+      const int value_size = GDALGetDataTypeSizeBytes(eDataType);
+      if (m_staged) {
+        if (valid_rows < nBlockYSize || valid_cols < nBlockXSize) {
+          memset(p_data, 0, static_cast<size_t>(pixels_in_block) * value_size);
+        }
+        if (read_staged(first_col, first_row, valid_cols, valid_rows, p_data, eDataType,
+          value_size, static_cast<GSpacing>(nBlockXSize) * value_size)) {
+          return CE_None;
+        }
+      }
+
+      if (m_prefetcher) {
+        m_prefetcher->read_block(major_row, major_col, p_data);
+      }
+      else {
+        m_block_generator->fill_block(major_row, major_col, p_data, pixels_in_block);
+      }
+      observe_block(major_row, major_col, p_data, value_size, static_cast<GSpacing>(nBlockXSize) * value_size);
+
+      if (static_cast<random_raster_dataset*>(poDS)->is_pixel_interleaved()) {
+        fill_sibling_blocks(nBlockXOff, nBlockYOff);
+      }
+      return CE_None;
+    }
+
+    void random_raster_band::fill_sibling_blocks(int nBlockXOff, int nBlockYOff)
+    {
+      for (int i = 1; i <= poDS->GetRasterCount(); ++i) {
+        if (i == nBand) {
+          continue;
+        }
+        random_raster_band* sibling = static_cast<random_raster_band*>(poDS->GetRasterBand(i));
+        GDALRasterBlock* block = sibling->TryGetLockedBlockRef(nBlockXOff, nBlockYOff);
+        if (block == nullptr) {
+          // Only initializes the block, IReadBlock of the sibling is not 
+          // called.
+          block = sibling->GetLockedBlockRef(nBlockXOff, nBlockYOff, TRUE);
+          if (block == nullptr) {
+            continue; // e.g. the block cache is full, the sibling will generate it when read
+          }
+          sibling->m_block_generator->fill_block(nBlockYOff, nBlockXOff, block->GetDataRef(),
+            nBlockXSize * nBlockYSize);
+          const int value_size = GDALGetDataTypeSizeBytes(sibling->eDataType);
+          sibling->observe_block(nBlockYOff, nBlockXOff, block->GetDataRef(), value_size,
+            static_cast<GSpacing>(nBlockXSize) * value_size);
+        }
+        block->DropLock();
+      }
+    }
+
+    CPLErr random_raster_band::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+      void* pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+      GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg* psExtraArg)
+    {
+      // Writing and resampling are left to GDAL.
+      if (eRWFlag != GF_Read || nXSize != nBufXSize || nYSize != nBufYSize || m_block_generator == nullptr) {
+        return GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+          pData, nBufXSize, nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
+      }
+
+      if (!read_staged(nXOff, nYOff, nXSize, nYSize, pData, eBufType, nPixelSpace, nLineSpace)) {
+        generate_window(nXOff, nYOff, nXSize, nYSize, pData, eBufType, nPixelSpace, nLineSpace,
+          static_cast<random_raster_dataset*>(poDS)->get_thread_pool());
+      }
+      return CE_None;
+    }
+
+    void random_raster_band::generate_window(int nXOff, int nYOff, int nXSize, int nYSize,
+      void* pData, GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace, thread_pool* pool)
+    {
+      const int first_block_row = nYOff / nBlockYSize;
+      const int first_block_col = nXOff / nBlockXSize;
+      const int block_rows = (nYOff + nYSize - 1) / nBlockYSize - first_block_row + 1;
+      const int block_cols = (nXOff + nXSize - 1) / nBlockXSize - first_block_col + 1;
+      if (block_rows * block_cols < 2) {
+        read_window(nXOff, nYOff, nXSize, nYSize, pData, eBufType, nPixelSpace, nLineSpace);
+        return;
+      }
+
+      // The window is split on the block boundaries, so that every part is
+      // generated independently, and with the same values as in a single 
+      // thread. This also lets the moments of the whole blocks be observed.
+      auto read_part = [&](size_t part) {
+        const int major_row = first_block_row + static_cast<int>(part / block_cols);
+        const int major_col = first_block_col + static_cast<int>(part % block_cols);
+        const int row_begin = std::max(nYOff, major_row * nBlockYSize);
+        const int row_end = std::min(nYOff + nYSize, (major_row + 1) * nBlockYSize);
+        const int col_begin = std::max(nXOff, major_col * nBlockXSize);
+        const int col_end = std::min(nXOff + nXSize, (major_col + 1) * nBlockXSize);
+        GByte* part_data = static_cast<GByte*>(pData)
+          + (row_begin - nYOff) * nLineSpace + (col_begin - nXOff) * nPixelSpace;
+        read_window(col_begin, row_begin, col_end - col_begin, row_end - row_begin,
+          part_data, eBufType, nPixelSpace, nLineSpace);
+        };
+      const size_t parts = static_cast<size_t>(block_rows) * block_cols;
+      if (pool != nullptr) {
+        pool->parallel_for(parts, read_part);
+      }
+      else {
+        for (size_t part = 0; part < parts; ++part) {
+          read_part(part);
+        }
+      }
+    }
+
+
+    CPLErr random_raster_band::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+      int nBufXSize, int nBufYSize, GDALDataType eBufType, CSLConstList /*papszOptions*/)
+    {
+      // Only windows at full resolution are staged, and only if they fit in
+      // the block cache.
+      if (nXSize != nBufXSize || nYSize != nBufYSize || nXSize <= 0 || nYSize <= 0
+        || nXOff < 0 || nYOff < 0 || nXOff + nXSize > nRasterXSize || nYOff + nYSize > nRasterYSize
+        || m_block_generator == nullptr) {
+        return CE_None;
+      }
+      if (eBufType == GDT_Unknown) {
+        eBufType = eDataType;
+      }
+      const int value_size = GDALGetDataTypeSizeBytes(eBufType);
+      const GIntBig bytes = static_cast<GIntBig>(nXSize) * nYSize * value_size;
+      if (bytes > GDALGetCacheMax64()) {
+        CPLDebug("RANDOM_RASTER", "AdviseRead window of " CPL_FRMT_GIB " bytes is too large to stage", bytes);
+        return CE_None;
+      }
+
+      discard_staged();
+      auto staged = std::make_unique<staged_window>();
+      staged->x_off = nXOff;
+      staged->y_off = nYOff;
+      staged->x_size = nXSize;
+      staged->y_size = nYSize;
+      staged->type = eBufType;
+      staged->data.resize(static_cast<size_t>(bytes));
+      staged_window* target = staged.get();
+      // Generated on a thread of its own and not on the thread pool, which
+      // would hold up the reads of the caller until the window is done.
+      staged->ready = std::async(std::launch::async, [this, target, value_size] {
+        generate_window(target->x_off, target->y_off, target->x_size, target->y_size, target->data.data(),
+          target->type, value_size, static_cast<GSpacing>(target->x_size) * value_size, nullptr);
+        });
+      m_staged = std::move(staged);
+      return CE_None;
+    }
+
+    void random_raster_band::discard_staged()
+    {
+      if (m_staged) {
+        m_staged->ready.wait();
+        m_staged.reset();
+      }
+    }
+
+    void random_raster_band::stop_background_work()
+    {
+      discard_staged();
+      set_prefetch(0, nullptr);
+    }
+
+    bool random_raster_band::read_staged(int nXOff, int nYOff, int nXSize, int nYSize,
+      void* pData, GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace)
+    {
+      staged_window* staged = m_staged.get();
+      if (staged == nullptr || staged->type != eBufType
+        || nXOff < staged->x_off || nYOff < staged->y_off
+        || nXOff + nXSize > staged->x_off + staged->x_size
+        || nYOff + nYSize > staged->y_off + staged->y_size) {
+        return false;
+      }
+      staged->ready.wait();
+      const int value_size = GDALGetDataTypeSizeBytes(eBufType);
+      const GSpacing staged_line_space = static_cast<GSpacing>(staged->x_size) * value_size;
+      for (int r = 0; r < nYSize; ++r) {
+        const GByte* source = staged->data.data()
+          + (nYOff - staged->y_off + r) * staged_line_space + static_cast<GSpacing>(nXOff - staged->x_off) * value_size;
+        GDALCopyWords64(source, eBufType, value_size,
+          static_cast<GByte*>(pData) + r * nLineSpace, eBufType, static_cast<int>(nPixelSpace), nXSize);
+      }
+
+      // Once as many values have been read as the window holds, it is 
+      // assumed to be consumed and its memory is released.
+      staged->values_read += static_cast<uint64_t>(nXSize) * nYSize;
+      if (staged->values_read >= static_cast<uint64_t>(staged->x_size) * staged->y_size) {
+        m_staged.reset();
+      }
+      return true;
+    }
+
+    void random_raster_band::read_window(int nXOff, int nYOff, int nXSize, int nYSize,
+      void* pData, GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace)
+    {
+      // Windows that are exactly one block are observed for the statistics.
+      const bool whole_block = nXOff % nBlockXSize == 0 && nYOff % nBlockYSize == 0
+        && nXSize == std::min(nBlockXSize, nRasterXSize - nXOff)
+        && nYSize == std::min(nBlockYSize, nRasterYSize - nYOff);
+
+      if (eBufType == eDataType) {
+        m_block_generator->fill_window(nYOff, nXOff, nYSize, nXSize, pData, nPixelSpace, nLineSpace);
+        if (whole_block) {
+          observe_block(nYOff / nBlockYSize, nXOff / nBlockXSize, pData, nPixelSpace, nLineSpace);
+        }
+        return;
+      }
+
+      // Other buffer types are generated one row of blocks at a time and 
+      // converted into the buffer.
+      const int value_size = GDALGetDataTypeSizeBytes(eDataType);
+      std::vector<GByte> strip;
+      int row = nYOff;
+      while (row < nYOff + nYSize) {
+        const int strip_end = std::min(nYOff + nYSize, (row / nBlockYSize + 1) * nBlockYSize);
+        const int strip_rows = strip_end - row;
+        const GSpacing strip_line_space = static_cast<GSpacing>(nXSize) * value_size;
+        strip.resize(static_cast<size_t>(strip_rows) * strip_line_space);
+        m_block_generator->fill_window(row, nXOff, strip_rows, nXSize, strip.data(), value_size, strip_line_space);
+        if (whole_block) {
+          observe_block(row / nBlockYSize, nXOff / nBlockXSize, strip.data(), value_size, strip_line_space);
+        }
+        for (int r = 0; r < strip_rows; ++r) {
+          GDALCopyWords64(strip.data() + r * strip_line_space, eDataType, value_size,
+            static_cast<GByte*>(pData) + (row - nYOff + r) * nLineSpace, eBufType,
+            static_cast<int>(nPixelSpace), nXSize);
+        }
+        row = strip_end;
+      }
+    }
+
+    void random_raster_band::create_overviews()
+    {
+      m_overviews_created = true;
+      if (m_block_generator == nullptr || !m_block_generator->pixel_addressable()) {
+        return;
+      }
+      int rows = nRasterYSize;
+      int cols = nRasterXSize;
+      for (int factor = 2; rows > nBlockYSize || cols > nBlockXSize; factor *= 2) {
+        rows = (nRasterYSize + factor - 1) / factor;
+        cols = (nRasterXSize + factor - 1) / factor;
+        m_overviews.push_back(std::make_unique<random_raster_overview_band>(poDS, nBand,
+          m_block_generator, eDataType, nRasterYSize, nRasterXSize, rows, cols, nBlockYSize, nBlockXSize));
+      }
+    }
+
+    int random_raster_band::GetOverviewCount()
+    {
+      if (!m_overviews_created) {
+        create_overviews();
+      }
+      return static_cast<int>(m_overviews.size());
+    }
+
+    GDALRasterBand* random_raster_band::GetOverview(int i)
+    {
+      if (i < 0 || i >= GetOverviewCount()) {
+        return nullptr;
+      }
+      return m_overviews[i].get();
+    }
+
+    void random_raster_band::observe_block(int major_row, int major_col, const void* data,
+      GSpacing pixel_space, GSpacing line_space)
+    {
+      const int blocks_in_row = (nRasterXSize + nBlockXSize - 1) / nBlockXSize;
+      const int blocks_in_column = (nRasterYSize + nBlockYSize - 1) / nBlockYSize;
+      const size_t index = static_cast<size_t>(major_row) * blocks_in_row + major_col;
+      {
+        std::lock_guard<std::mutex> lock(m_moments_mutex);
+        if (!m_block_observed.empty() && m_block_observed[index]) {
+          return;
+        }
+      }
+
+      const int rows = std::min(nBlockYSize, nRasterYSize - major_row * nBlockYSize);
+      const int cols = std::min(nBlockXSize, nRasterXSize - major_col * nBlockXSize);
+      int has_nodata = FALSE;
+      double nodata = GetNoDataValue(&has_nodata);
+      if (!has_nodata) {
+        nodata = std::numeric_limits<double>::quiet_NaN();
+      }
+      const raster_moments moments = band_moments(eDataType, data, rows, cols, pixel_space, line_space, nodata);
+
+      std::lock_guard<std::mutex> lock(m_moments_mutex);
+      if (m_block_observed.empty()) {
+        const size_t blocks = static_cast<size_t>(blocks_in_row) * blocks_in_column;
+        m_block_observed.assign(blocks, false);
+        m_block_moments.assign(blocks, raster_moments{});
+      }
+      if (!m_block_observed[index]) {
+        m_block_observed[index] = true;
+        m_block_moments[index] = moments;
+        ++m_blocks_observed;
+      }
+    }
+
+    bool random_raster_band::observed_moments(raster_moments& moments)
+    {
+      std::lock_guard<std::mutex> lock(m_moments_mutex);
+      if (m_block_observed.empty() || m_blocks_observed < m_block_observed.size()) {
+        return false;
+      }
+
+      // Merged in the order of the blocks, so that the result does not 
+      // depend on the order in which they were generated.
+      moments = raster_moments{};
+      for (const raster_moments& block : m_block_moments) {
+        moments.merge(block);
+      }
+      return true;
+    }
+
+    bool random_raster_band::compute_moments(raster_moments& moments, GDALProgressFunc pfnProgress,
+      void* pProgressData)
+    {
+      const int blocks_in_row = (nRasterXSize + nBlockXSize - 1) / nBlockXSize;
+      const int blocks_in_column = (nRasterYSize + nBlockYSize - 1) / nBlockYSize;
+      const size_t values_in_block = static_cast<size_t>(nBlockXSize) * nBlockYSize;
+      const int value_size = GDALGetDataTypeSizeBytes(eDataType);
+
+      // Buffers are handed out to the threads and returned after use, so
+      // there are no more of them than there are threads.
+      std::mutex buffers_mutex;
+      std::vector<std::vector<GByte>> buffers;
+
+      int major_row = 0;
+      auto observe = [&](size_t major_col) {
+        {
+          std::lock_guard<std::mutex> lock(m_moments_mutex);
+          const size_t index = static_cast<size_t>(major_row) * blocks_in_row + major_col;
+          if (!m_block_observed.empty() && m_block_observed[index]) {
+            return;
+          }
+        }
+        std::vector<GByte> buffer;
+        {
+          std::lock_guard<std::mutex> lock(buffers_mutex);
+          if (!buffers.empty()) {
+            buffer = std::move(buffers.back());
+            buffers.pop_back();
+          }
+        }
+        buffer.resize(values_in_block * value_size);
+        m_block_generator->fill_block(major_row, static_cast<int>(major_col), buffer.data(),
+          static_cast<int>(values_in_block));
+        observe_block(major_row, static_cast<int>(major_col), buffer.data(), value_size,
+          static_cast<GSpacing>(nBlockXSize) * value_size);
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        buffers.push_back(std::move(buffer));
+        };
+
+      // One row of blocks at a time, so that progress can be reported.
+      thread_pool* pool = static_cast<random_raster_dataset*>(poDS)->get_thread_pool();
+      for (; major_row < blocks_in_column; ++major_row) {
+        if (pool != nullptr) {
+          pool->parallel_for(blocks_in_row, observe);
+        }
+        else {
+          for (int major_col = 0; major_col < blocks_in_row; ++major_col) {
+            observe(major_col);
+          }
+        }
+        if (!pfnProgress((major_row + 1.0) / blocks_in_column, "", pProgressData)) {
+          CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+          return false;
+        }
+      }
+
+      moments = raster_moments{};
+      observed_moments(moments);
+      return true;
+    }
+
+    void random_raster_band::publish_statistics(const raster_moments& moments)
+    {
+      SetStatistics(moments.min, moments.max, moments.mean, std::sqrt(moments.variance()));
+      const double total = static_cast<double>(nRasterXSize) * nRasterYSize;
+      SetMetadataItem("STATISTICS_VALID_PERCENT", CPLSPrintf("%.4g", 100.0 * moments.count / total));
+    }
+
+    CPLErr random_raster_band::ComputeStatistics(int bApproxOK, double* pdfMin, double* pdfMax,
+      double* pdfMean, double* pdfStdDev, GDALProgressFunc pfnProgress, void* pProgressData)
+    {
+      if (m_block_generator == nullptr) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Block generator is null when computing statistics.");
+        return CE_Failure;
+      }
+
+      // Where approximate statistics are acceptable and the band has 
+      // overviews, GDAL takes them from an overview, unless the exact 
+      // statistics are known already. Otherwise the exact statistics are 
+      // computed.
+      raster_moments moments;
+      const bool observed = observed_moments(moments);
+      if (!observed && bApproxOK && GetOverviewCount() > 0) {
+        return GDALPamRasterBand::ComputeStatistics(bApproxOK, pdfMin, pdfMax, pdfMean, pdfStdDev,
+          pfnProgress, pProgressData);
+      }
+      if (pfnProgress == nullptr) {
+        pfnProgress = GDALDummyProgress;
+      }
+      if (!pfnProgress(0.0, "", pProgressData)) {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+      }
+
+      if (!observed && !compute_moments(moments, pfnProgress, pProgressData)) {
+        return CE_Failure;
+      }
+      if (moments.count == 0) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Failed to compute statistics, no valid pixels found in sampling.");
+        return CE_Failure;
+      }
+      publish_statistics(moments);
+
+      if (pdfMin) *pdfMin = moments.min;
+      if (pdfMax) *pdfMax = moments.max;
+      if (pdfMean) *pdfMean = moments.mean;
+      if (pdfStdDev) *pdfStdDev = std::sqrt(moments.variance());
+      pfnProgress(1.0, "", pProgressData);
       return CE_None;
     }
 
+    // The range of the band, from the observed blocks if they are all 
+    // known, from the distribution if an approximation suffices.
+    CPLErr random_raster_band::ComputeRasterMinMax(int bApproxOK, double* adfMinMax)
+    {
+      if (m_block_generator == nullptr) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Block generator is null when computing minimum and maximum.");
+        return CE_Failure;
+      }
+      raster_moments moments;
+      if (!observed_moments(moments)) {
+        if (bApproxOK) {
+          adfMinMax[0] = m_block_generator->get_min();
+          adfMinMax[1] = m_block_generator->get_max();
+          return CE_None;
+        }
+        if (!compute_moments(moments, GDALDummyProgress, nullptr)) {
+          return CE_Failure;
+        }
+      }
+      if (moments.count == 0) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Failed to compute min/max, no valid pixels found in sampling.");
+        return CE_Failure;
+      }
+      adfMinMax[0] = moments.min;
+      adfMinMax[1] = moments.max;
+      return CE_None;
+    }
+
+    double random_raster_band::GetNoDataValue(int* pbSuccess)
+    {
+      const nodata_mask* mask = static_cast<random_raster_dataset*>(poDS)->get_nodata_mask();
+      if (mask == nullptr) {
+        return GDALPamRasterBand::GetNoDataValue(pbSuccess);
+      }
+      if (pbSuccess) *pbSuccess = TRUE;
+      return mask->value();
+    }
+
+    GDALRasterBand* random_raster_band::GetMaskBand()
+    {
+      GDALRasterBand* mask_band = static_cast<random_raster_dataset*>(poDS)->get_mask_band();
+      return mask_band != nullptr ? mask_band : GDALPamRasterBand::GetMaskBand();
+    }
+
+    int random_raster_band::GetMaskFlags()
+    {
+      if (static_cast<random_raster_dataset*>(poDS)->get_nodata_mask() == nullptr) {
+        return GDALPamRasterBand::GetMaskFlags();
+      }
+      return GMF_PER_DATASET;
+    }
+
+    int random_raster_band::IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize, int nYSize,
+      int nMaskFlagStop, double* pdfDataPct)
+    {
+      const nodata_mask* mask = static_cast<random_raster_dataset*>(poDS)->get_nodata_mask();
+      if (mask == nullptr) {
+        if (pdfDataPct) *pdfDataPct = 100.0;
+        return GDAL_DATA_COVERAGE_STATUS_DATA;
+      }
+
+      // Blocks that are missing entirely, or not at all, are known without
+      // looking at the cells.
+      constexpr int both = GDAL_DATA_COVERAGE_STATUS_DATA | GDAL_DATA_COVERAGE_STATUS_EMPTY;
+      int status = 0;
+      uint64_t valid = 0;
+      for (int major_row = nYOff / nBlockYSize; major_row * nBlockYSize < nYOff + nYSize; ++major_row) {
+        const int row_begin = std::max(nYOff, major_row * nBlockYSize);
+        const int row_end = std::min(nYOff + nYSize, (major_row + 1) * nBlockYSize);
+        for (int major_col = nXOff / nBlockXSize; major_col * nBlockXSize < nXOff + nXSize; ++major_col) {
+          const int col_begin = std::max(nXOff, major_col * nBlockXSize);
+          const int col_end = std::min(nXOff + nXSize, (major_col + 1) * nBlockXSize);
+          const uint64_t cells = static_cast<uint64_t>(row_end - row_begin) * (col_end - col_begin);
+          uint64_t block_valid = 0;
+          if (mask->block_is_complete(major_row, major_col)) {
+            block_valid = cells;
+          }
+          else if (!mask->block_is_missing(major_row, major_col)) {
+            for (int r = row_begin; r < row_end; ++r) {
+              for (int c = col_begin; c < col_end; ++c) {
+                block_valid += mask->is_missing(r, c) ? 0 : 1;
+              }
+            }
+          }
+          valid += block_valid;
+          status |= block_valid > 0 ? GDAL_DATA_COVERAGE_STATUS_DATA : 0;
+          status |= block_valid < cells ? GDAL_DATA_COVERAGE_STATUS_EMPTY : 0;
+
+          // Stops early if the caller does not need to know more, the 
+          // percentage is then unknown.
+          if ((status & nMaskFlagStop) != 0 || (pdfDataPct == nullptr && status == both)) {
+            if (pdfDataPct) *pdfDataPct = -1.0;
+            return status;
+          }
+        }
+      }
+      if (pdfDataPct) {
+        *pdfDataPct = 100.0 * static_cast<double>(valid) / (static_cast<double>(nXSize) * nYSize);
+      }
+      return status;
+    }
+
+    uint64_t random_raster_band::expected_valid_count() const
+    {
+      const uint64_t cells = static_cast<uint64_t>(nRasterXSize) * nRasterYSize;
+      const nodata_mask* mask = static_cast<random_raster_dataset*>(poDS)->get_nodata_mask();
+      if (mask == nullptr) {
+        return cells;
+      }
+      return static_cast<uint64_t>(std::llround(static_cast<double>(cells) * (1.0 - mask->probability())));
+    }
+
     // Returns the minimum possible value.
     double random_raster_band::GetMinimum(int* pbSuccess)
     {
@@ -61,7 +666,8 @@ namespace pronto {
       return m_block_generator->get_max();
     }
 
-    // Provides basic statistics.
+    // Provides the sample statistics if they are known, otherwise the 
+    // statistics of the distribution.
     CPLErr random_raster_band::GetStatistics(int bApproxOK, int bForce, double* pdfMin, double* pdfMax,
                                            double* pdfMean, double* pdfStdDev)
     {
@@ -70,6 +676,24 @@ namespace pronto {
         return CE_Failure;
       }
 
+      // Statistics that were computed before, or saved with the dataset.
+      raster_moments moments;
+      if (GDALPamRasterBand::GetStatistics(bApproxOK, FALSE, pdfMin, pdfMax, pdfMean, pdfStdDev) == CE_None) {
+        return CE_None;
+      }
+      if (observed_moments(moments) && moments.count > 0) {
+        publish_statistics(moments);
+        if (pdfMin) *pdfMin = moments.min;
+        if (pdfMax) *pdfMax = moments.max;
+        if (pdfMean) *pdfMean = moments.mean;
+        if (pdfStdDev) *pdfStdDev = std::sqrt(moments.variance());
+        return CE_None;
+      }
+
+      if (!m_block_generator->get_value_distribution().has_moments()) {
+        return GDALPamRasterBand::GetStatistics(bApproxOK, bForce, pdfMin, pdfMax, pdfMean, pdfStdDev);
+      }
+
       if (pdfMin) *pdfMin = m_block_generator->get_min();
       if (pdfMax) *pdfMax = m_block_generator->get_max();
       if (pdfMean) *pdfMean = m_block_generator->get_mean();
@@ -77,5 +701,66 @@ namespace pronto {
 
       return CE_None;
     }
+
+    // Provides the expected histogram where an approximation is allowed, 
+    // and otherwise counts the values of the generated raster.
+    CPLErr random_raster_band::GetHistogram(double dfMin, double dfMax, int nBuckets, GUIntBig* panHistogram,
+      int bIncludeOutOfRange, int bApproxOK, GDALProgressFunc pfnProgress, void* pProgressData)
+    {
+      if (!bApproxOK || m_block_generator == nullptr || !m_block_generator->get_value_distribution().available()
+        || nBuckets <= 0 || !(dfMax > dfMin)) {
+        return GDALPamRasterBand::GetHistogram(dfMin, dfMax, nBuckets, panHistogram,
+          bIncludeOutOfRange, bApproxOK, pfnProgress, pProgressData);
+      }
+
+      std::vector<uint64_t> counts(nBuckets);
+      m_block_generator->get_value_distribution().histogram(dfMin, dfMax, nBuckets, bIncludeOutOfRange != FALSE,
+        expected_valid_count(), counts.data());
+      std::copy(counts.begin(), counts.end(), panHistogram);
+      if (pfnProgress != nullptr) {
+        pfnProgress(1.0, "", pProgressData);
+      }
+      return CE_None;
+    }
+
+    // Provides the expected histogram over the range of the values, as the
+    // default histogram does not require reading the band. A histogram that
+    // was saved with the dataset takes precedence.
+    CPLErr random_raster_band::GetDefaultHistogram(double* pdfMin, double* pdfMax, int* pnBuckets,
+      GUIntBig** ppanHistogram, int bForce, GDALProgressFunc pfnProgress, void* pProgressData)
+    {
+      if (m_block_generator == nullptr || !m_block_generator->get_value_distribution().available()
+        || GDALPamRasterBand::GetDefaultHistogram(pdfMin, pdfMax, pnBuckets, ppanHistogram,
+          FALSE, nullptr, nullptr) == CE_None) {
+        return GDALPamRasterBand::GetDefaultHistogram(pdfMin, pdfMax, pnBuckets, ppanHistogram,
+          bForce, pfnProgress, pProgressData);
+      }
+
+      double min = m_block_generator->get_min();
+      double max = m_block_generator->get_max();
+      int buckets = 256;
+      if (GDALDataTypeIsInteger(eDataType)) {
+        // One bucket per value where possible.
+        buckets = static_cast<int>(std::min(256.0, max - min + 1.0));
+        min -= 0.5;
+        max += 0.5;
+      }
+      else {
+        // As GDAL, so that the extremes are in the middle of the outer 
+        // buckets.
+        const double half_bucket = max > min ? (max - min) / (2.0 * (buckets - 1)) : 0.5;
+        min -= half_bucket;
+        max += half_bucket;
+      }
+
+      *pdfMin = min;
+      *pdfMax = max;
+      *pnBuckets = buckets;
+      *ppanHistogram = static_cast<GUIntBig*>(VSI_CALLOC_VERBOSE(sizeof(GUIntBig), buckets));
+      if (*ppanHistogram == nullptr) {
+        return CE_Failure;
+      }
+      return GetHistogram(min, max, buckets, *ppanHistogram, TRUE, TRUE, pfnProgress, pProgressData);
+    }
   } // namespace raster
 } // namespace pronto
\ No newline at end of file
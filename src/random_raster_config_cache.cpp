@@ -0,0 +1,70 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/random_raster_config_cache.h>
+
+#include <cpl_conv.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace pronto {
+  namespace raster {
+
+    random_raster_config_cache& random_raster_config_cache::instance()
+    {
+      static random_raster_config_cache cache;
+      return cache;
+    }
+
+    std::size_t random_raster_config_cache::capacity()
+    {
+      const int size = atoi(CPLGetConfigOption("RANDOM_RASTER_CONFIG_CACHE", "256"));
+      return static_cast<std::size_t>(std::max(0, size));
+    }
+
+    std::shared_ptr<const random_raster_definition> random_raster_config_cache::find(const std::string& contents)
+    {
+      if (capacity() == 0) {
+        return nullptr;
+      }
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto i = m_index.find(contents);
+      if (i == m_index.end()) {
+        return nullptr;
+      }
+      m_entries.splice(m_entries.begin(), m_entries, i->second);
+      return i->second->second;
+    }
+
+    void random_raster_config_cache::insert(const std::string& contents,
+      std::shared_ptr<const random_raster_definition> definition)
+    {
+      if (!definition->reproducible) {
+        return;
+      }
+      const std::size_t max_entries = capacity();
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto i = m_index.find(contents);
+      if (i != m_index.end()) {
+        m_entries.erase(i->second);
+        m_index.erase(i);
+      }
+      if (max_entries > 0) {
+        m_entries.emplace_front(contents, std::move(definition));
+        m_index.emplace(contents, m_entries.begin());
+      }
+      while (m_entries.size() > max_entries) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+      }
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -7,100 +7,204 @@
 //=======================================================================
 //
 
-#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <memory.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include <cpl_conv.h>
+#include <cpl_string.h>
 #include <gdal_priv.h>
 #include <ogr_spatialref.h> // For OGRSpatialReference
 
 #include <pronto/raster/block_generator_interface.h> 
 #include <pronto/raster/random_raster_band.h>
+#include <pronto/raster/random_raster_config_cache.h>
 #include <pronto/raster/random_raster_dataset.h>
+#include <pronto/raster/random_raster_mask_band.h>
 #define PRONTO_RASTER_MAX_JSON_FILE_SIZE (10 * 1024 * 1024) // 10 MB limit
+#define PRONTO_RASTER_MAX_IDENTIFY_BYTES (64 * 1024) // 64 kB limit
 
 namespace pronto {
   namespace raster {
 
      // Private constructor.
-    random_raster_dataset::random_raster_dataset(int rows, int cols, GDALDataType data_type,
-        int block_rows, int block_cols, std::unique_ptr<block_generator_interface>&& block_generator)
-        : m_block_generator(std::move(block_generator))
-    {
-      nRasterXSize = cols;
-      nRasterYSize = rows;
-      SetBand(1, new random_raster_band(this, 1, m_block_generator.get(),
-        data_type, block_rows, block_cols));
-    }
-    nlohmann::json read_json_from_GDALOpenInfo(GDALOpenInfo* openInfo)
-    {
-      // Simplify boolean declaration for clarity
-      const bool is_purely_in_memory_buffer = openInfo->pabyHeader != nullptr && openInfo->nHeaderBytes > 0;
-      std::string content_to_parse;
-      std::string dataset_id = ""; // Name for GDAL's description/PAM
-      if (is_purely_in_memory_buffer)
-      {
-        content_to_parse.assign(reinterpret_cast<const char*>(openInfo->pabyHeader), openInfo->nHeaderBytes);
-        dataset_id = "random_raster_in_memory_data"; // Generic ID for in-memory
-      }
-      else if (openInfo->pszFilename != nullptr && strlen(openInfo->pszFilename) > 0)
-      {
-        dataset_id = openInfo->pszFilename; // Filename is the ID for PAM and dataset description
-        VSILFILE* fp = VSIFOpenL(openInfo->pszFilename, "rb");
-
-        if (fp == nullptr) {
-          std::string msg = std::string( "File/resource can't be opened: ") + openInfo->pszFilename;
-          throw std::runtime_error(msg);
-        }
-        VSIFSeekL(fp, 0, SEEK_END);
-        vsi_l_offset file_size = VSIFTellL(fp);
-        VSIFSeekL(fp, 0, SEEK_SET);
-        if (file_size > PRONTO_RASTER_MAX_JSON_FILE_SIZE) {
-          CPLError(CE_Failure, CPLE_AppDefined, "JSON file too large (%lld bytes) for in-memory parsing: %s",
-            static_cast<long long>(file_size), openInfo->pszFilename);
-          VSIFCloseL(fp);
-          std::string msg = std::string("JSON file too large for parsing as a RANDOM_RASTER");
-          throw std::runtime_error(msg);
-        }
-        content_to_parse.resize(static_cast<size_t>(file_size));
-        size_t bytes_read = VSIFReadL(&content_to_parse[0], 1, static_cast<size_t>(file_size), fp);
-        VSIFCloseL(fp);
+    random_raster_dataset::random_raster_dataset(const random_raster_definition& definition)
+        : m_block_generators(definition.block_generators)
+        , m_pixel_interleaved(definition.pixel_interleaved)
+        , m_nodata_mask(definition.mask)
+    {
+      nRasterXSize = definition.cols;
+      nRasterYSize = definition.rows;
+      for (size_t i = 0; i < m_block_generators.size(); ++i) {
+        const int n_band = static_cast<int>(i) + 1;
+        SetBand(n_band, new random_raster_band(this, n_band, m_block_generators[i].get(),
+          definition.data_types[i], definition.block_rows, definition.block_cols));
+      }
+      // Bypasses PAM, as this is not a property to be saved.
+      GDALDataset::SetMetadataItem("INTERLEAVE", m_pixel_interleaved ? "PIXEL" : "BAND", "IMAGE_STRUCTURE");
+    }
 
-        if (bytes_read != static_cast<size_t>(file_size)) {
-          std::string msg = std::string("JSON file not completely read when parsing as a RANDOM_RASTER");
-          throw std::runtime_error(msg);
-        }
+    // The contents of the configuration file. Small files are entirely in
+    // the header that GDAL has read already.
+    std::string read_config_from_GDALOpenInfo(GDALOpenInfo* openInfo)
+    {
+      if (openInfo->pszFilename == nullptr || strlen(openInfo->pszFilename) == 0) {
+        throw std::runtime_error("No data source (filename or buffer) provided.");
       }
-      else {
-        std::string msg = std::string("No data source (filename or buffer) provided.");
+      VSILFILE* fp = openInfo->fpL != nullptr ? openInfo->fpL : VSIFOpenL(openInfo->pszFilename, "rb");
+      if (fp == nullptr) {
+        std::string msg = std::string("File/resource can't be opened: ") + openInfo->pszFilename;
         throw std::runtime_error(msg);
       }
+      VSIFSeekL(fp, 0, SEEK_END);
+      vsi_l_offset file_size = VSIFTellL(fp);
+      VSIFSeekL(fp, 0, SEEK_SET);
+      if (file_size > PRONTO_RASTER_MAX_JSON_FILE_SIZE) {
+        CPLError(CE_Failure, CPLE_AppDefined, "JSON file too large (%lld bytes) for in-memory parsing: %s",
+          static_cast<long long>(file_size), openInfo->pszFilename);
+        if (fp != openInfo->fpL) VSIFCloseL(fp);
+        throw std::runtime_error("JSON file too large for parsing as a RANDOM_RASTER");
+      }
 
-      // --- JSON Parsing ---
-      return nlohmann::json::parse(content_to_parse);
+      std::string contents;
+      if (openInfo->pabyHeader != nullptr && file_size <= static_cast<vsi_l_offset>(openInfo->nHeaderBytes)) {
+        contents.assign(reinterpret_cast<const char*>(openInfo->pabyHeader), static_cast<size_t>(file_size));
+      }
+      else {
+        contents.resize(static_cast<size_t>(file_size));
+        const size_t bytes_read = VSIFReadL(&contents[0], 1, contents.size(), fp);
+        if (bytes_read != contents.size()) {
+          if (fp != openInfo->fpL) VSIFCloseL(fp);
+          throw std::runtime_error("JSON file not completely read when parsing as a RANDOM_RASTER");
+        }
+      }
+      if (fp != openInfo->fpL) {
+        VSIFCloseL(fp);
+      }
+      return contents;
+    }
+
+    // The opening brace of the JSON object that the text starts with, null
+    // if it does not start with one.
+    const char* find_json_object(const char* text, size_t size)
+    {
+      const char* end = text + size;
+      const char* p = text;
+      if (size >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0) {
+        p += 3; // UTF-8 byte order mark
+      }
+      while (p != end && isspace(static_cast<unsigned char>(*p))) ++p;
+      return p != end && *p == '{' ? p : nullptr;
     }
 
+    // Whether the text starts like a random raster configuration: a JSON
+    // object with "type": "RANDOM_RASTER" among its members. Only looks for
+    // the literal text, so that other JSON files are rejected without
+    // parsing them.
+    bool sniff_random_raster(const char* text, size_t size)
+    {
+      const char* end = text + size;
+      const char* p = find_json_object(text, size);
+      if (p == nullptr) {
+        return false;
+      }
+      const std::string type_value = "\"RANDOM_RASTER\"";
+      const std::string type_key = "\"type\"";
+      for (const char* value = std::search(p, end, type_value.begin(), type_value.end()); value != end;
+        value = std::search(value + 1, end, type_value.begin(), type_value.end())) {
+        const char* q = value;
+        while (q != p && isspace(static_cast<unsigned char>(q[-1]))) --q;
+        if (q == p || q[-1] != ':') continue;
+        --q;
+        while (q != p && isspace(static_cast<unsigned char>(q[-1]))) --q;
+        if (q - p >= static_cast<std::ptrdiff_t>(type_key.size())
+          && std::equal(type_key.begin(), type_key.end(), q - type_key.size())) {
+          return true;
+        }
+      }
+      return false;
+    }
     
+    // Number of threads for a NUM_THREADS value, which is a number or 
+    // ALL_CPUS.
+    int parse_num_threads(const char* value)
+    {
+      if (EQUAL(value, "ALL_CPUS")) {
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+      }
+      const int num_threads = atoi(value);
+      if (num_threads < 1) {
+        CPLError(CE_Warning, CPLE_IllegalArg, "Invalid value for NUM_THREADS: %s, using 1 thread", value);
+        return 1;
+      }
+      return num_threads;
+    }
+
+    // Only inspects the header, so it is cheap for the many files that GDAL
+    // probes. A configuration whose "type" is beyond the header is looked 
+    // for in the first PRONTO_RASTER_MAX_IDENTIFY_BYTES bytes.
     int random_raster_dataset::Identify(GDALOpenInfo* openInfo)
     {
-      try {
-        auto j = read_json_from_GDALOpenInfo(openInfo);
-        if (j.contains("type") && j["type"] == "RANDOM_RASTER") {
-          return TRUE; // Identified as a RANDOM_RASTER type
-        }
-      } catch(std::exception& e){
-        // clear exceptions, should not throw, but quitely return FALSE
+      if (openInfo->pabyHeader == nullptr || openInfo->nHeaderBytes == 0) {
+        return FALSE;
+      }
+      const char* header = reinterpret_cast<const char*>(openInfo->pabyHeader);
+      if (sniff_random_raster(header, openInfo->nHeaderBytes)) {
+        return TRUE;
+      }
+      const bool is_json_object = find_json_object(header, openInfo->nHeaderBytes) != nullptr;
+      if (is_json_object && openInfo->nHeaderBytes < PRONTO_RASTER_MAX_IDENTIFY_BYTES
+        && openInfo->TryToIngest(PRONTO_RASTER_MAX_IDENTIFY_BYTES)) {
+        header = reinterpret_cast<const char*>(openInfo->pabyHeader);
+        return sniff_random_raster(header, openInfo->nHeaderBytes) ? TRUE : FALSE;
       }
       return FALSE;
-
     }
+
     GDALDataset* random_raster_dataset::create_from_generator(
       int rows, int cols, GDALDataType data_type,
       int block_rows, int block_cols, std::unique_ptr<block_generator_interface>&& block_generator)
     {
-      return new random_raster_dataset(rows, cols, data_type, 
-        block_rows, block_cols, std::move(block_generator));
+      std::vector<std::unique_ptr<block_generator_interface>> block_generators;
+      block_generators.push_back(std::move(block_generator));
+      return create_from_generators(rows, cols, { data_type },
+        block_rows, block_cols, std::move(block_generators), false);
     };
 
+    GDALDataset* random_raster_dataset::create_from_generators(
+      int rows, int cols, const std::vector<GDALDataType>& data_types,
+      int block_rows, int block_cols, std::vector<std::unique_ptr<block_generator_interface>>&& block_generators,
+      bool pixel_interleaved, std::unique_ptr<nodata_mask>&& mask)
+    {
+      random_raster_definition definition;
+      definition.rows = rows;
+      definition.cols = cols;
+      definition.block_rows = block_rows;
+      definition.block_cols = block_cols;
+      definition.data_types = data_types;
+      for (auto& block_generator : block_generators) {
+        definition.block_generators.push_back(std::move(block_generator));
+      }
+      definition.pixel_interleaved = pixel_interleaved;
+      definition.mask = std::move(mask);
+      return create_from_definition(definition);
+    }
+
+    GDALDataset* random_raster_dataset::create_from_definition(const random_raster_definition& definition)
+    {
+      return new random_raster_dataset(definition);
+    }
+
+    GDALDataset* random_raster_dataset::create_from_json(const nlohmann::json& json_params)
+    {
+      return create_from_definition(*definition_from_json(json_params));
+    }
+
     // GDAL driver entry point for opening datasets.
     GDALDataset* random_raster_dataset::Open(GDALOpenInfo* openInfo)
     {
@@ -108,20 +212,31 @@ namespace pronto {
         return nullptr; // Not a random raster dataset, quietly return nullptr.
       }
       try {
-        nlohmann::json j = read_json_from_GDALOpenInfo(openInfo);
-        random_raster_dataset* poDS = static_cast<random_raster_dataset*>(create_from_json(j));;
-
-        // Set the virtual flag and PAM description based on source type
-
-        const bool is_purely_in_memory_buffer = openInfo->pabyHeader != nullptr && openInfo->nHeaderBytes > 0;
-        std::string dataset_id = ""; // Name for GDAL's description/PAM
-        if (is_purely_in_memory_buffer)
-        {
-         dataset_id = is_purely_in_memory_buffer  
-           ? "random_raster_in_memory_data" 
-           : openInfo->pszFilename; 
-         }
+        // The configuration is parsed once, and not at all when the same
+        // configuration was opened before.
+        const std::string contents = read_config_from_GDALOpenInfo(openInfo);
+        random_raster_config_cache& cache = random_raster_config_cache::instance();
+        std::shared_ptr<const random_raster_definition> definition = cache.find(contents);
+        if (!definition) {
+          definition = definition_from_json(nlohmann::json::parse(contents));
+          cache.insert(contents, definition);
+        }
+        random_raster_dataset* poDS = static_cast<random_raster_dataset*>(create_from_definition(*definition));
+
+        // Set the virtual flag and PAM description based on source type. 
+        // Datasets opened from a file are described by the file name, so
+        // that PAM information (e.g. computed statistics) is kept in an 
+        // .aux.xml file next to it.
+        const bool is_purely_in_memory_buffer = !openInfo->bStatOK;
+        const std::string dataset_id = is_purely_in_memory_buffer // Name for GDAL's description/PAM
+          ? "random_raster_in_memory_data"
+          : openInfo->pszFilename;
         poDS->m_bIsVirtual = is_purely_in_memory_buffer; // Simpler assignment
+        const int num_threads = parse_num_threads(CSLFetchNameValueDef(openInfo->papszOpenOptions, "NUM_THREADS",
+          CPLGetConfigOption("GDAL_NUM_THREADS", "1")));
+        poDS->set_num_threads(num_threads);
+        const char* prefetch_depth = CSLFetchNameValueDef(openInfo->papszOpenOptions, "PREFETCH_DEPTH", "0");
+        poDS->set_prefetch(std::max(0, atoi(prefetch_depth)), num_threads);
         poDS->SetDescription(dataset_id.c_str());
         if (!is_purely_in_memory_buffer) {
           poDS->TryLoadXML(openInfo->GetSiblingFiles());
@@ -134,6 +249,142 @@ namespace pronto {
         return nullptr; // Return nullptr on failure
       }
     }
+    CPLErr random_raster_dataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+      void* pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+      int nBandCount, BANDMAP_TYPE panBandMap, GSpacing nPixelSpace, GSpacing nLineSpace,
+      GSpacing nBandSpace, GDALRasterIOExtraArg* psExtraArg)
+    {
+      // Writing and resampling are left to GDAL.
+      if (eRWFlag != GF_Read || nXSize != nBufXSize || nYSize != nBufYSize) {
+        return GDALPamDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+          pData, nBufXSize, nBufYSize, eBufType, nBandCount, panBandMap,
+          nPixelSpace, nLineSpace, nBandSpace, psExtraArg);
+      }
+
+      // Bands with the window staged by AdviseRead copy it, the other bands
+      // are generated together one block at a time. That way, the part of
+      // the buffer for a block is completed for all bands while it is in 
+      // cache, which matters for pixel interleaved buffers.
+      std::vector<std::pair<random_raster_band*, GByte*>> pending;
+      for (int i = 0; i < nBandCount; ++i) {
+        random_raster_band* band = static_cast<random_raster_band*>(GetRasterBand(panBandMap[i]));
+        GByte* band_data = static_cast<GByte*>(pData) + i * nBandSpace;
+        if (!band->read_staged(nXOff, nYOff, nXSize, nYSize, band_data, eBufType, nPixelSpace, nLineSpace)) {
+          pending.emplace_back(band, band_data);
+        }
+      }
+      if (pending.empty()) {
+        return CE_None;
+      }
+
+      int block_x_size, block_y_size;
+      pending.front().first->GetBlockSize(&block_x_size, &block_y_size);
+      const int first_block_row = nYOff / block_y_size;
+      const int first_block_col = nXOff / block_x_size;
+      const int block_rows = (nYOff + nYSize - 1) / block_y_size - first_block_row + 1;
+      const int block_cols = (nXOff + nXSize - 1) / block_x_size - first_block_col + 1;
+      auto read_part = [&](size_t part) {
+        const int major_row = first_block_row + static_cast<int>(part / block_cols);
+        const int major_col = first_block_col + static_cast<int>(part % block_cols);
+        const int row_begin = std::max(nYOff, major_row * block_y_size);
+        const int row_end = std::min(nYOff + nYSize, (major_row + 1) * block_y_size);
+        const int col_begin = std::max(nXOff, major_col * block_x_size);
+        const int col_end = std::min(nXOff + nXSize, (major_col + 1) * block_x_size);
+        const GSpacing offset = (row_begin - nYOff) * nLineSpace + (col_begin - nXOff) * nPixelSpace;
+        for (const auto& band : pending) {
+          band.first->read_window(col_begin, row_begin, col_end - col_begin, row_end - row_begin,
+            band.second + offset, eBufType, nPixelSpace, nLineSpace);
+        }
+        };
+      const size_t parts = static_cast<size_t>(block_rows) * block_cols;
+      if (m_thread_pool && parts > 1) {
+        m_thread_pool->parallel_for(parts, read_part);
+      }
+      else {
+        for (size_t part = 0; part < parts; ++part) {
+          read_part(part);
+        }
+      }
+      return CE_None;
+    }
+
+    random_raster_dataset::~random_raster_dataset()
+    {
+      // The background work of the bands uses the block generator, and is 
+      // stopped before it is destroyed.
+      for (int i = 1; i <= GetRasterCount(); ++i) {
+        static_cast<random_raster_band*>(GetRasterBand(i))->stop_background_work();
+      }
+    }
+
+    CPLErr random_raster_dataset::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+      int nBufXSize, int nBufYSize, GDALDataType eBufType,
+      int nBandCount, int* panBandList, CSLConstList papszOptions)
+    {
+      for (int i = 0; i < nBandCount; ++i) {
+        const int band = panBandList == nullptr ? i + 1 : panBandList[i];
+        CPLErr err = GetRasterBand(band)->AdviseRead(nXOff, nYOff, nXSize, nYSize,
+          nBufXSize, nBufYSize, eBufType, papszOptions);
+        if (err != CE_None) {
+          return err;
+        }
+      }
+      return CE_None;
+    }
+
+    void random_raster_dataset::set_prefetch(int depth, int num_threads)
+    {
+      for (int i = 1; i <= GetRasterCount(); ++i) {
+        static_cast<random_raster_band*>(GetRasterBand(i))->set_prefetch(0, nullptr);
+      }
+      m_prefetch_workers.reset();
+      if (depth > 0) {
+        m_prefetch_workers = std::make_unique<background_workers>(std::max(1, num_threads));
+      }
+      for (int i = 1; i <= GetRasterCount(); ++i) {
+        static_cast<random_raster_band*>(GetRasterBand(i))->set_prefetch(depth, m_prefetch_workers.get());
+      }
+    }
+
+    void random_raster_dataset::set_num_threads(int num_threads)
+    {
+      if (num_threads > 1) {
+        m_thread_pool = std::make_unique<thread_pool>(num_threads);
+      }
+      else {
+        m_thread_pool.reset();
+      }
+    }
+
+    thread_pool* random_raster_dataset::get_thread_pool() const
+    {
+      return m_thread_pool.get();
+    }
+
+    bool random_raster_dataset::is_pixel_interleaved() const
+    {
+      return m_pixel_interleaved;
+    }
+
+    const nodata_mask* random_raster_dataset::get_nodata_mask() const
+    {
+      return m_nodata_mask.get();
+    }
+
+    GDALRasterBand* random_raster_dataset::get_mask_band()
+    {
+      if (!m_nodata_mask) {
+        return nullptr;
+      }
+      if (!m_mask_band) {
+        int block_cols;
+        int block_rows;
+        GetRasterBand(1)->GetBlockSize(&block_cols, &block_rows);
+        m_mask_band = std::make_unique<random_raster_mask_band>(this, *m_nodata_mask, block_rows, block_cols);
+      }
+      return m_mask_band.get();
+    }
+
     CPLErr random_raster_dataset::GetGeoTransform(double* padfTransform)
     {
       // A default GeoTransform: 1x1 pixel size, no rotation, origin at (0,0)
@@ -9,6 +9,7 @@
 
 #include <gdal_priv.h>
 #include <pronto/raster/random_raster_dataset.h>
+#include <pronto/raster/simd_kernels.h>
 
 
 // Register the driver with GDAL when the library is loaded.
@@ -29,10 +30,23 @@ extern "C" {
     driver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
     driver->SetMetadataItem(GDAL_DCAP_RASTER, "YES");
     driver->SetMetadataItem(GDAL_DMD_EXTENSION, "json");
+    driver->SetMetadataItem(GDAL_DMD_OPENOPTIONLIST,
+      "<OpenOptionList>"
+      "  <Option name='NUM_THREADS' type='string' description='Number of threads "
+      "used to generate reads that span several blocks: an integer or ALL_CPUS. "
+      "Defaults to the GDAL_NUM_THREADS configuration option, or 1.'/>"
+      "  <Option name='PREFETCH_DEPTH' type='int' min='0' default='0' description='Number "
+      "of blocks generated ahead on background threads when blocks are read "
+      "sequentially. 0 disables prefetching.'/>"
+      "</OpenOptionList>");
 
     driver->pfnOpen = pronto::raster::random_raster_dataset::Open;
     driver->pfnIdentify = pronto::raster::random_raster_dataset::Identify;
 
     GetGDALDriverManager()->RegisterDriver(driver);
+
+    // Select the SIMD kernels once, when the plugin is loaded.
+    CPLDebug("RANDOM_RASTER", "Using %s SIMD kernels",
+      pronto::raster::get_simd_kernels().name);
   }
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+#include <algorithm>
+#include <cstring>
+
+#include <pronto/raster/random_raster_mask_band.h>
+
+namespace pronto {
+  namespace raster {
+
+    random_raster_mask_band::random_raster_mask_band(GDALDataset* ds, const nodata_mask& mask,
+      int block_rows, int block_cols)
+      : m_mask(mask)
+    {
+      poDS = ds;
+      nBand = 0;
+      eDataType = GDT_Byte;
+      nRasterXSize = ds->GetRasterXSize();
+      nRasterYSize = ds->GetRasterYSize();
+      nBlockXSize = block_cols;
+      nBlockYSize = block_rows;
+    }
+
+    CPLErr random_raster_mask_band::IReadBlock(int nBlockXOff, int nBlockYOff, void* p_data)
+    {
+      const int first_row = nBlockYOff * nBlockYSize;
+      const int first_col = nBlockXOff * nBlockXSize;
+      const int valid_rows = std::min(nBlockYSize, nRasterYSize - first_row);
+      const int valid_cols = std::min(nBlockXSize, nRasterXSize - first_col);
+      GByte* block = static_cast<GByte*>(p_data);
+      if (valid_rows < nBlockYSize || valid_cols < nBlockXSize) {
+        memset(block, 0, static_cast<size_t>(nBlockXSize) * nBlockYSize);
+      }
+      if (m_mask.block_is_missing(nBlockYOff, nBlockXOff)) {
+        return CE_None;
+      }
+      if (m_mask.block_is_complete(nBlockYOff, nBlockXOff)) {
+        for (int r = 0; r < valid_rows; ++r) {
+          memset(block + static_cast<size_t>(r) * nBlockXSize, 255, valid_cols);
+        }
+        return CE_None;
+      }
+      m_mask.fill_mask(first_row, first_col, valid_rows, valid_cols, block, nBlockXSize);
+      return CE_None;
+    }
+
+    int random_raster_mask_band::GetMaskFlags()
+    {
+      return GMF_ALL_VALID;
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,326 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Command line tool that writes the raster of a random raster configuration
+// to a tiled GeoTIFF or a Cloud Optimized GeoTIFF (COG).
+//
+// A GeoTIFF is written in windows of whole tiles, at most one row of tiles
+// high, so that memory is bounded. While a window is written, the next one
+// is generated, with its blocks divided over the threads of the dataset
+// (the NUM_THREADS open option). The GeoTIFF driver compresses the tiles on
+// its own threads (the NUM_THREADS creation option) and writes them in
+// order.
+//
+// A COG is copied from the dataset by the COG driver, which reads the
+// overviews from the virtual overviews of the dataset where it has them.
+
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cpl_conv.h>
+#include <cpl_string.h>
+#include <gdal.h>
+#include <gdal_priv.h>
+
+// The driver is linked in, so that the tool does not depend on
+// GDAL_DRIVER_PATH.
+extern "C" void GDALRegister_RANDOM_RASTER();
+
+namespace {
+
+  struct materialize_options
+  {
+    std::string format = "GTiff";
+    CPLStringList creation_options;
+    std::string num_threads = "ALL_CPUS";
+    int tile_size = 512;
+    int max_memory = 256; // MB, for the two windows in flight
+    bool quiet = false;
+    std::string config;
+    std::string output;
+  };
+
+  void print_usage()
+  {
+    std::cerr <<
+      "Usage: random_raster_materialize [-of GTiff|COG] [-co NAME=VALUE]...\n"
+      "                                 [-threads N|ALL_CPUS] [-tile_size N]\n"
+      "                                 [-max_memory MB] [-q] config.json output.tif\n"
+      "\n"
+      "  -of          Output format, GTiff (tiled) or COG. Default: GTiff.\n"
+      "  -co          Creation option of the output driver, may be repeated.\n"
+      "  -threads     Threads for generating and for compressing. Default: ALL_CPUS.\n"
+      "  -tile_size   Width and height of the tiles, a multiple of 16. Default: 512.\n"
+      "  -max_memory  Memory for the windows being generated and written, in MB.\n"
+      "               Default: 256.\n"
+      "  -q           Quiet, no progress.\n";
+  }
+
+  // Parses the arguments, returns false if they are invalid.
+  bool parse_arguments(int argc, char** argv, materialize_options& options)
+  {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      const bool has_value = i + 1 < argc;
+      if (arg == "-of" && has_value) {
+        options.format = argv[++i];
+      }
+      else if (arg == "-co" && has_value) {
+        options.creation_options.AddString(argv[++i]);
+      }
+      else if (arg == "-threads" && has_value) {
+        options.num_threads = argv[++i];
+      }
+      else if (arg == "-tile_size" && has_value) {
+        options.tile_size = atoi(argv[++i]);
+      }
+      else if (arg == "-max_memory" && has_value) {
+        options.max_memory = atoi(argv[++i]);
+      }
+      else if (arg == "-q") {
+        options.quiet = true;
+      }
+      else if (!arg.empty() && arg[0] == '-') {
+        std::cerr << "Unknown or incomplete option: " << arg << "\n";
+        return false;
+      }
+      else {
+        positional.push_back(arg);
+      }
+    }
+    if (positional.size() != 2) {
+      return false;
+    }
+    if (!EQUAL(options.format.c_str(), "GTiff") && !EQUAL(options.format.c_str(), "COG")) {
+      std::cerr << "The output format must be GTiff or COG, not " << options.format << "\n";
+      return false;
+    }
+    if (options.tile_size < 16 || options.tile_size % 16 != 0) {
+      std::cerr << "The tile size must be a positive multiple of 16\n";
+      return false;
+    }
+    if (options.max_memory < 1) {
+      std::cerr << "The memory must be at least 1 MB\n";
+      return false;
+    }
+    options.config = positional[0];
+    options.output = positional[1];
+    return true;
+  }
+
+  // Sets the creation option, unless it is given on the command line.
+  void set_default(CPLStringList& creation_options, const char* name, const std::string& value)
+  {
+    if (creation_options.FetchNameValue(name) == nullptr) {
+      creation_options.SetNameValue(name, value.c_str());
+    }
+  }
+
+  // The data type that holds the values of all bands.
+  GDALDataType common_data_type(GDALDataset* source)
+  {
+    GDALDataType type = source->GetRasterBand(1)->GetRasterDataType();
+    for (int i = 2; i <= source->GetRasterCount(); ++i) {
+      type = GDALDataTypeUnion(type, source->GetRasterBand(i)->GetRasterDataType());
+    }
+    return type;
+  }
+
+  // Closes the dataset, which writes the tiles that are still cached.
+  bool close_dataset(GDALDataset* dataset, const std::string& name)
+  {
+    CPLErrorReset();
+    GDALClose(dataset);
+    if (CPLGetLastErrorType() == CE_Failure) {
+      std::cerr << "Could not complete " << name << ": " << CPLGetLastErrorMsg() << "\n";
+      return false;
+    }
+    return true;
+  }
+
+  struct tile_window
+  {
+    int col;
+    int row;
+    int cols;
+    int rows;
+  };
+
+  // Windows of whole tiles, in the order of the tiles in the file.
+  std::vector<tile_window> tile_windows(int raster_rows, int raster_cols, int tile_rows, int tile_cols,
+    int tiles_per_window)
+  {
+    std::vector<tile_window> windows;
+    const int window_cols = tile_cols * tiles_per_window;
+    for (int row = 0; row < raster_rows; row += tile_rows) {
+      for (int col = 0; col < raster_cols; col += window_cols) {
+        windows.push_back({ col, row, std::min(window_cols, raster_cols - col),
+          std::min(tile_rows, raster_rows - row) });
+      }
+    }
+    return windows;
+  }
+
+  bool write_gtiff(GDALDataset* source, const materialize_options& options)
+  {
+    const int rows = source->GetRasterYSize();
+    const int cols = source->GetRasterXSize();
+    const int bands = source->GetRasterCount();
+    const GDALDataType type = common_data_type(source);
+    const int value_size = GDALGetDataTypeSizeBytes(type);
+
+    CPLStringList creation_options(options.creation_options);
+    set_default(creation_options, "TILED", "YES");
+    set_default(creation_options, "BLOCKXSIZE", std::to_string(options.tile_size));
+    set_default(creation_options, "BLOCKYSIZE", std::to_string(options.tile_size));
+    set_default(creation_options, "COMPRESS", "DEFLATE");
+    set_default(creation_options, "BIGTIFF", "IF_SAFER");
+    set_default(creation_options, "NUM_THREADS", options.num_threads);
+    if (bands > 1) {
+      set_default(creation_options, "INTERLEAVE", "PIXEL");
+    }
+
+    GDALDriver* driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (driver == nullptr) {
+      std::cerr << "The GTiff driver is not available\n";
+      return false;
+    }
+    GDALDataset* target = driver->Create(options.output.c_str(), cols, rows, bands, type,
+      creation_options.List());
+    if (target == nullptr) {
+      std::cerr << "Could not create " << options.output << ": " << CPLGetLastErrorMsg() << "\n";
+      return false;
+    }
+    double geo_transform[6];
+    if (source->GetGeoTransform(geo_transform) == CE_None) {
+      target->SetGeoTransform(geo_transform);
+    }
+    if (source->GetSpatialRef() != nullptr) {
+      target->SetSpatialRef(source->GetSpatialRef());
+    }
+    for (int i = 1; i <= bands; ++i) {
+      int has_nodata = FALSE;
+      const double nodata = source->GetRasterBand(i)->GetNoDataValue(&has_nodata);
+      if (has_nodata) {
+        target->GetRasterBand(i)->SetNoDataValue(nodata);
+      }
+    }
+
+    // Two windows are in flight, one being generated and one being written.
+    int tile_cols, tile_rows;
+    target->GetRasterBand(1)->GetBlockSize(&tile_cols, &tile_rows);
+    const double tile_bytes = static_cast<double>(tile_rows) * tile_cols * bands * value_size;
+    const double budget = options.max_memory * 1024.0 * 1024.0 / 2.0;
+    const int tiles_in_row = (cols + tile_cols - 1) / tile_cols;
+    const int tiles_per_window = std::clamp(static_cast<int>(budget / tile_bytes), 1, tiles_in_row);
+    const std::vector<tile_window> windows = tile_windows(rows, cols, tile_rows, tile_cols, tiles_per_window);
+
+    const size_t buffer_size = static_cast<size_t>(tile_rows) * tile_cols * tiles_per_window * bands * value_size;
+    std::vector<GByte> generated(buffer_size);
+    std::vector<GByte> written(buffer_size);
+    auto generate = [&](const tile_window& w, GByte* buffer) {
+      const GSpacing line_space = static_cast<GSpacing>(w.cols) * bands * value_size;
+      return source->RasterIO(GF_Read, w.col, w.row, w.cols, w.rows, buffer, w.cols, w.rows, type,
+        bands, nullptr, bands * value_size, line_space, value_size, nullptr);
+      };
+
+    bool ok = true;
+    std::future<CPLErr> next = std::async(std::launch::async, generate, windows[0], generated.data());
+    for (size_t i = 0; i < windows.size() && ok; ++i) {
+      ok = next.get() == CE_None;
+      if (!ok) {
+        std::cerr << "Could not generate the raster: " << CPLGetLastErrorMsg() << "\n";
+        break;
+      }
+      std::swap(generated, written);
+      if (i + 1 < windows.size()) {
+        next = std::async(std::launch::async, generate, windows[i + 1], generated.data());
+      }
+      const tile_window& w = windows[i];
+      const GSpacing line_space = static_cast<GSpacing>(w.cols) * bands * value_size;
+      ok = target->RasterIO(GF_Write, w.col, w.row, w.cols, w.rows, written.data(), w.cols, w.rows, type,
+        bands, nullptr, bands * value_size, line_space, value_size, nullptr) == CE_None;
+      if (!ok) {
+        std::cerr << "Could not write " << options.output << ": " << CPLGetLastErrorMsg() << "\n";
+      }
+      if (!options.quiet) {
+        GDALTermProgress(static_cast<double>(i + 1) / windows.size(), nullptr, nullptr);
+      }
+    }
+    if (next.valid()) {
+      next.wait();
+    }
+    return close_dataset(target, options.output) && ok;
+  }
+
+  bool write_cog(GDALDataset* source, const materialize_options& options)
+  {
+    CPLStringList creation_options(options.creation_options);
+    set_default(creation_options, "BLOCKSIZE", std::to_string(options.tile_size));
+    set_default(creation_options, "COMPRESS", "DEFLATE");
+    set_default(creation_options, "BIGTIFF", "IF_SAFER");
+    set_default(creation_options, "NUM_THREADS", options.num_threads);
+
+    GDALDriver* driver = GetGDALDriverManager()->GetDriverByName("COG");
+    if (driver == nullptr) {
+      std::cerr << "The COG driver is not available\n";
+      return false;
+    }
+    GDALDataset* target = driver->CreateCopy(options.output.c_str(), source, FALSE, creation_options.List(),
+      options.quiet ? GDALDummyProgress : GDALTermProgress, nullptr);
+    if (target == nullptr) {
+      std::cerr << "Could not create " << options.output << ": " << CPLGetLastErrorMsg() << "\n";
+      return false;
+    }
+    return close_dataset(target, options.output);
+  }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  GDALRegister_RANDOM_RASTER();
+  GDALAllRegister();
+  argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+  if (argc < 1) {
+    GDALDestroyDriverManager();
+    return argc == 0 ? 0 : 1;
+  }
+
+  materialize_options options;
+  if (!parse_arguments(argc, argv, options)) {
+    print_usage();
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+    return 1;
+  }
+  CSLDestroy(argv);
+
+  const std::string num_threads = std::string("NUM_THREADS=") + options.num_threads;
+  const char* allowed_drivers[] = { "RANDOM_RASTER", nullptr };
+  const char* open_options[] = { num_threads.c_str(), nullptr };
+  GDALDataset* source = GDALDataset::Open(options.config.c_str(), GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+    allowed_drivers, open_options);
+  if (source == nullptr) {
+    std::cerr << "Could not open " << options.config << " as a random raster\n";
+    GDALDestroyDriverManager();
+    return 1;
+  }
+
+  const bool ok = EQUAL(options.format.c_str(), "COG")
+    ? write_cog(source, options)
+    : write_gtiff(source, options);
+  GDALClose(source);
+  GDALDestroyDriverManager();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <pronto/raster/random_raster_overview_band.h>
+
+namespace pronto {
+  namespace raster {
+
+    // The same choice of pixels as GDAL's nearest neighbour resampling.
+    std::vector<int> nearest_source_indices(int full_size, int size)
+    {
+      std::vector<int> indices(size);
+      const double ratio = static_cast<double>(full_size) / size;
+      for (int i = 0; i < size; ++i) {
+        indices[i] = std::min(full_size - 1, static_cast<int>((i + 0.5) * ratio));
+      }
+      return indices;
+    }
+
+    random_raster_overview_band::random_raster_overview_band(GDALDataset* ds, int n_band,
+      block_generator_interface* block_gen, GDALDataType data_type, int full_rows, int full_cols,
+      int rows, int cols, int block_rows, int block_cols)
+      : m_block_generator(block_gen)
+      , m_source_rows(nearest_source_indices(full_rows, rows))
+      , m_source_cols(nearest_source_indices(full_cols, cols))
+    {
+      poDS = ds;
+      nBand = n_band;
+      eDataType = data_type;
+      nRasterXSize = cols;
+      nRasterYSize = rows;
+      nBlockXSize = std::min(block_cols, cols);
+      nBlockYSize = std::min(block_rows, rows);
+    }
+
+    void random_raster_overview_band::read_window(int nXOff, int nYOff, int nXSize, int nYSize,
+      void* pData, GSpacing nPixelSpace, GSpacing nLineSpace)
+    {
+      m_block_generator->fill_sampled(m_source_rows.data() + nYOff, nYSize,
+        m_source_cols.data() + nXOff, nXSize, pData, nPixelSpace, nLineSpace);
+    }
+
+    CPLErr random_raster_overview_band::IReadBlock(int nBlockXOff, int nBlockYOff, void* p_data)
+    {
+      if (m_block_generator == nullptr) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Block generator is null for random_raster_overview_band.");
+        return CE_Failure;
+      }
+      const int first_row = nBlockYOff * nBlockYSize;
+      const int first_col = nBlockXOff * nBlockXSize;
+      const int valid_rows = std::min(nBlockYSize, nRasterYSize - first_row);
+      const int valid_cols = std::min(nBlockXSize, nRasterXSize - first_col);
+      const int value_size = GDALGetDataTypeSizeBytes(eDataType);
+      if (valid_rows < nBlockYSize || valid_cols < nBlockXSize) {
+        memset(p_data, 0, static_cast<size_t>(nBlockXSize) * nBlockYSize * value_size);
+      }
+      read_window(first_col, first_row, valid_cols, valid_rows, p_data,
+        value_size, static_cast<GSpacing>(nBlockXSize) * value_size);
+      return CE_None;
+    }
+
+    CPLErr random_raster_overview_band::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+      void* pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+      GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg* psExtraArg)
+    {
+      // Writing, resampling and conversion are left to GDAL.
+      if (eRWFlag != GF_Read || nXSize != nBufXSize || nYSize != nBufYSize
+        || eBufType != eDataType || m_block_generator == nullptr) {
+        return GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+          pData, nBufXSize, nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
+      }
+      read_window(nXOff, nYOff, nXSize, nYSize, pData, nPixelSpace, nLineSpace);
+      return CE_None;
+    }
+
+    double random_raster_overview_band::GetNoDataValue(int* pbSuccess)
+    {
+      return poDS->GetRasterBand(nBand)->GetNoDataValue(pbSuccess);
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -10,6 +10,7 @@
 #include <limits>
 #include <chrono> // For std::chrono::system_clock
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 
 #include <nlohmann/json.hpp>
@@ -18,9 +19,19 @@
 #include <gdal_priv.h>
 #include <gdal_typetraits.h>
 
+#include <pronto/raster/block_engine.h>
 #include <pronto/raster/block_generator_interface.h>
+#include <pronto/raster/coherent_noise_field.h>
+#include <pronto/raster/continuous_cdf.h>
+#include <pronto/raster/field_block_generator.h>
+#include <pronto/raster/gaussian_random_field.h>
+#include <pronto/raster/inverse_cdf_sampler.h>
+#include <pronto/raster/nodata_block_generator.h>
+#include <pronto/raster/nodata_mask.h>
 #include <pronto/raster/random_block_generator.h> 
 #include <pronto/raster/random_raster_dataset.h> 
+#include <pronto/raster/smoothed_noise_field.h>
+#include <pronto/raster/voronoi_field.h>
 namespace pronto {
   namespace raster {
 // An enum to represent all supported distributions
@@ -48,7 +59,13 @@ namespace pronto {
       // Sampling Distributions
       discrete,
       piecewise_constant,
-      piecewise_linear
+      piecewise_linear,
+      // Spatial Fields
+      gaussian_random_field,
+      perlin,
+      simplex,
+      fbm,
+      voronoi
     };
 
     // Helper function to convert a string to our distribution_type enum
@@ -73,7 +90,12 @@ namespace pronto {
         {"chi_squared", distribution_type::chi_squared},
         {"discrete", distribution_type::discrete},
         {"piecewise_constant", distribution_type::piecewise_constant},
-        {"piecewise_linear", distribution_type::piecewise_linear}
+        {"piecewise_linear", distribution_type::piecewise_linear},
+        {"gaussian_random_field", distribution_type::gaussian_random_field},
+        {"perlin", distribution_type::perlin},
+        {"simplex", distribution_type::simplex},
+        {"fbm", distribution_type::fbm},
+        {"voronoi", distribution_type::voronoi}
       };
 
       auto it = dist_map.find(dist_str);
@@ -107,7 +129,12 @@ namespace pronto {
         {distribution_type::chi_squared, "chi_squared"},
         {distribution_type::discrete, "discrete"},
         {distribution_type::piecewise_constant, "piecewise_constant"},
-        {distribution_type::piecewise_linear, "piecewise_linear"}
+        {distribution_type::piecewise_linear, "piecewise_linear"},
+        {distribution_type::gaussian_random_field, "gaussian_random_field"},
+        {distribution_type::perlin, "perlin"},
+        {distribution_type::simplex, "simplex"},
+        {distribution_type::fbm, "fbm"},
+        {distribution_type::voronoi, "voronoi"}
       };
       auto it = dist_map.find(dt);
       if (it != dist_map.end()) {
@@ -116,6 +143,179 @@ namespace pronto {
       return "unspecified_or_unknown_distribution";
     }
 
+    // An enum to represent all supported random engines
+    enum class engine_type {
+      mt19937_64,
+      philox4x64,
+      threefry4x64,
+      xoshiro256pp,
+      pcg64
+    };
+
+    // Helper function to convert a string to our engine_type enum
+    engine_type string_to_engine_type(const std::string& engine_str) {
+      static const std::map<std::string, engine_type> engine_map = {
+        {"mt19937_64", engine_type::mt19937_64},
+        {"philox4x64", engine_type::philox4x64},
+        {"threefry4x64", engine_type::threefry4x64},
+        {"xoshiro256++", engine_type::xoshiro256pp},
+        {"pcg64", engine_type::pcg64}
+      };
+
+      auto it = engine_map.find(engine_str);
+      if (it != engine_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(engine_str + " is not a supported random engine");
+      }
+    }
+
+    // Helper function to convert a string to the addressing_mode enum
+    addressing_mode string_to_addressing_mode(const std::string& addressing_str) {
+      static const std::map<std::string, addressing_mode> addressing_map = {
+        {"block", addressing_mode::block},
+        {"pixel", addressing_mode::pixel}
+      };
+
+      auto it = addressing_map.find(addressing_str);
+      if (it != addressing_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(addressing_str + " is not a supported addressing mode");
+      }
+    }
+
+    // An enum to represent the ways of sampling from a distribution
+    enum class sampling_mode {
+      direct,           // Sampler specific to the distribution
+      inverse_cdf_table // Interpolation in a table of the inverse CDF
+    };
+
+    // Helper function to convert a string to the sampling_mode enum
+    sampling_mode string_to_sampling_mode(const std::string& sampling_str) {
+      static const std::map<std::string, sampling_mode> sampling_map = {
+        {"direct", sampling_mode::direct},
+        {"inverse_cdf_table", sampling_mode::inverse_cdf_table}
+      };
+
+      auto it = sampling_map.find(sampling_str);
+      if (it != sampling_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(sampling_str + " is not a supported sampling mode");
+      }
+    }
+
+    // Helper function to convert a string to the nodata_pattern enum
+    nodata_pattern string_to_nodata_pattern(const std::string& pattern_str) {
+      static const std::map<std::string, nodata_pattern> pattern_map = {
+        {"pixel", nodata_pattern::pixel},
+        {"block", nodata_pattern::block}
+      };
+
+      auto it = pattern_map.find(pattern_str);
+      if (it != pattern_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(pattern_str + " is not a supported nodata pattern");
+      }
+    }
+
+    covariance_model string_to_covariance_model(const std::string& covariance_str) {
+      static const std::map<std::string, covariance_model> covariance_map = {
+        {"exponential", covariance_model::exponential},
+        {"gaussian", covariance_model::gaussian},
+        {"matern", covariance_model::matern}
+      };
+      auto it = covariance_map.find(covariance_str);
+      if (it != covariance_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(covariance_str + " is not a supported covariance model");
+      }
+    }
+
+    smoothing_kernel string_to_smoothing_kernel(const std::string& kernel_str) {
+      static const std::map<std::string, smoothing_kernel> kernel_map = {
+        {"box", smoothing_kernel::box},
+        {"gaussian", smoothing_kernel::gaussian},
+        {"exponential", smoothing_kernel::exponential}
+      };
+      auto it = kernel_map.find(kernel_str);
+      if (it != kernel_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(kernel_str + " is not a supported smoothing kernel");
+      }
+    }
+
+    noise_basis string_to_noise_basis(const std::string& basis_str) {
+      static const std::map<std::string, noise_basis> basis_map = {
+        {"perlin", noise_basis::perlin},
+        {"simplex", noise_basis::simplex}
+      };
+      auto it = basis_map.find(basis_str);
+      if (it != basis_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(basis_str + " is not a supported noise basis");
+      }
+    }
+
+    struct sampling_options {
+      sampling_mode mode;
+      double min; // Truncation bounds, infinite if not truncated
+      double max;
+    };
+
+    // An enum to represent the ways of aggregating fine resolution cells
+    enum class aggregate_op {
+      sum,
+      mean
+    };
+
+    // Helper function to convert a string to the aggregate_op enum
+    aggregate_op string_to_aggregate_op(const std::string& op_str) {
+      static const std::map<std::string, aggregate_op> op_map = {
+        {"sum", aggregate_op::sum},
+        {"mean", aggregate_op::mean}
+      };
+
+      auto it = op_map.find(op_str);
+      if (it != op_map.end()) {
+        return it->second;
+      }
+      else {
+        throw std::runtime_error(op_str + " is not a supported aggregate op");
+      }
+    }
+
+    // The mean of integer values is not an integer.
+    void require_sum(aggregate_op op, const std::string& distribution_name) {
+      if (op != aggregate_op::sum) {
+        throw std::runtime_error("Aggregate op 'mean' is not supported for the integer distribution " 
+          + distribution_name + ", use 'sum'");
+      }
+    }
+
+    // Checks that the parameter of an aggregated distribution, times the 
+    // number of aggregated cells, is in the range of the raster data type.
+    template<typename RasterValueType, typename ValueType>
+    ValueType aggregate_count_param(ValueType value, long long count, const std::string& key) {
+      const long double product = static_cast<long double>(value) * count;
+      if (product > static_cast<long double>(std::numeric_limits<RasterValueType>::max())) {
+        throw std::runtime_error("Parameter '" + key + "' times the number of aggregated cells exceeds the range of the data type");
+      }
+      return static_cast<ValueType>(value * count);
+    }
+
     template <typename ValueType>
     ValueType get_required_param_no_bounds(
       const nlohmann::json& j,
@@ -174,7 +374,7 @@ namespace pronto {
       return value;
     }
     // Overload for vector types where min/max bounds are not applicable
-    template <typename Vector, typename ElementType = Vector::value_type>
+    template <typename Vector, typename ElementType = typename Vector::value_type>
     std::vector<ElementType> get_required_param_vector(const nlohmann::json& j, const std::string& key) {
       if (!j.contains(key)) {
         throw std::runtime_error("Missing required parameter: '" + key + "'");
@@ -187,6 +387,18 @@ namespace pronto {
       }
     }
 
+    template <typename ValueType>
+    ValueType get_optional_param_no_bounds(
+      const nlohmann::json& j,
+      const std::string& key,
+      const ValueType& default_value)
+    {
+      if (!j.contains(key)) {
+        return default_value;
+      }
+      return get_required_param_no_bounds<ValueType>(j, key);
+    }
+
     template <typename ValueType>
     ValueType get_optional_param(
       const nlohmann::json& j,
@@ -204,7 +416,8 @@ namespace pronto {
     class maker_base {
     public:
       virtual ~maker_base() = default;
-      virtual GDALDataset* make(const nlohmann::json& params) = 0;
+      // Makes the block generator for the band with the given stream.
+      virtual std::unique_ptr<block_generator_interface> make(const nlohmann::json& params, uint64_t stream) = 0;
     };
 
     template <typename DistributionType, typename RasterValueType>
@@ -217,13 +430,25 @@ namespace pronto {
     template <typename DistributionType, typename RasterValueType>
     class typed_maker_base <maker<DistributionType, RasterValueType> > : public maker_base {
     public:
-      GDALDataset* make(const nlohmann::json& j) final 
+      std::unique_ptr<block_generator_interface> make(const nlohmann::json& j, uint64_t stream) final 
       {
         auto distribution_params = 
           get_required_param_no_bounds<nlohmann::json>(j, "distribution_parameters");
 
         auto* derived = static_cast<maker<DistributionType, RasterValueType>*>(this);
         DistributionType dist = derived->distribution_from_json(distribution_params);
+
+        // Each cell holds the sum or mean of factor x factor cells of an 
+        // unmaterialized fine resolution raster, sampled directly from the 
+        // distribution of the aggregate.
+        if (j.contains("aggregate")) {
+          auto aggregate = get_required_param_no_bounds<nlohmann::json>(j, "aggregate");
+          int factor = get_required_param<int>(aggregate, "factor", { 1,true });
+          auto op_str = get_optional_param_no_bounds<std::string>(aggregate, "op", "sum");
+          dist = derived->aggregate_distribution(dist, static_cast<long long>(factor) * factor,
+            string_to_aggregate_op(op_str));
+        }
+
         int rows = get_required_param<int>(j, "rows", { 1,true }); // Rows must be at least 1
         int cols = get_required_param<int>(j, "cols", { 1,true }); // Cols must be at least 1
 
@@ -232,10 +457,80 @@ namespace pronto {
 
         int block_rows = get_optional_param<int>(j, "block_rows", 256, { 1,true });
         int block_cols = get_optional_param<int>(j, "block_cols", 256, { 1,true });
-        GDALDataType gdal_type = gdal::CXXTypeTraits<RasterValueType>::gdal_type;
-        using random_block_generator_type = random_block_generator<DistributionType, RasterValueType>;
-        std::unique_ptr<block_generator_interface>  generator = std::make_unique<random_block_generator_type>(seed, rows, cols, block_rows, block_cols, dist);
-        return random_raster_dataset::create_from_generator(rows, cols, gdal_type, block_rows, block_cols, std::move(generator));
+        auto addressing_str = get_optional_param_no_bounds<std::string>(j, "addressing", "block");
+        addressing_mode addressing = string_to_addressing_mode(addressing_str);
+
+        // Pixel addressing needs an engine that can be keyed per pixel.
+        const std::string default_engine = 
+          addressing == addressing_mode::pixel ? "philox4x64" : "mt19937_64";
+        auto engine_str = get_optional_param_no_bounds<std::string>(j, "engine", default_engine);
+        engine_type engine = string_to_engine_type(engine_str);
+        if (addressing == addressing_mode::pixel && engine == engine_type::mt19937_64) {
+          throw std::runtime_error("Pixel addressing is not supported for the " + engine_str + " engine");
+        }
+
+        sampling_options sampling{ sampling_mode::direct,
+          -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity() };
+        auto sampling_str = get_optional_param_no_bounds<std::string>(j, "sampling", "direct");
+        sampling.mode = string_to_sampling_mode(sampling_str);
+        if (j.contains("truncation")) {
+          if (sampling.mode != sampling_mode::inverse_cdf_table) {
+            throw std::runtime_error("Parameter 'truncation' requires \"sampling\": \"inverse_cdf_table\"");
+          }
+          auto truncation = get_required_param_no_bounds<nlohmann::json>(j, "truncation");
+          sampling.min = get_optional_param<double>(truncation, "min", sampling.min);
+          sampling.max = get_optional_param<double>(truncation, "max", sampling.max);
+        }
+
+        std::unique_ptr<block_generator_interface> generator;
+        switch (engine) {
+        case engine_type::philox4x64:
+          generator = make_generator<philox4x64_engine>(seed, rows, cols, block_rows, block_cols, dist, addressing, stream, sampling);
+          break;
+        case engine_type::threefry4x64:
+          generator = make_generator<threefry4x64_engine>(seed, rows, cols, block_rows, block_cols, dist, addressing, stream, sampling);
+          break;
+        case engine_type::xoshiro256pp:
+          generator = make_generator<xoshiro256pp_engine>(seed, rows, cols, block_rows, block_cols, dist, addressing, stream, sampling);
+          break;
+        case engine_type::pcg64:
+          generator = make_generator<pcg64_engine>(seed, rows, cols, block_rows, block_cols, dist, addressing, stream, sampling);
+          break;
+        default:
+          generator = make_generator<std::mt19937_64>(seed, rows, cols, block_rows, block_cols, dist, addressing, stream, sampling);
+          break;
+        }
+        return generator;
+      }
+
+      // Distribution of the sum or mean of count independent values, makers of
+      // distributions that are closed under summation hide this.
+      DistributionType aggregate_distribution(const DistributionType&, long long, aggregate_op) const
+      {
+        throw std::runtime_error("Parameter 'aggregate' is only supported for the poisson, binomial, "
+          "negative_binomial, normal and gamma distributions");
+      }
+
+    private:
+      template<class Generator>
+      static std::unique_ptr<block_generator_interface> make_generator(uint64_t seed, 
+        int rows, int cols, int block_rows, int block_cols, const DistributionType& dist,
+        addressing_mode addressing, uint64_t stream, const sampling_options& sampling)
+      {
+        if (sampling.mode == sampling_mode::inverse_cdf_table) {
+          if constexpr (continuous_cdf<DistributionType>::available) {
+            using sampler_type = inverse_cdf_sampler<DistributionType, RasterValueType>;
+            using random_block_generator_type = 
+              random_block_generator<DistributionType, RasterValueType, Generator, sampler_type>;
+            return std::make_unique<random_block_generator_type>(seed, rows, cols, block_rows, block_cols,
+              sampler_type(dist, sampling.min, sampling.max), addressing, stream);
+          }
+          else {
+            throw std::runtime_error("Sampling inverse_cdf_table is only supported for continuous distributions");
+          }
+        }
+        using random_block_generator_type = random_block_generator<DistributionType, RasterValueType, Generator>;
+        return std::make_unique<random_block_generator_type>(seed, rows, cols, block_rows, block_cols, dist, addressing, stream);
       }
     };
 
@@ -275,6 +570,13 @@ namespace pronto {
         auto p = get_required_param<double>(j, "p", { 0.0, true }, { 1.0, true }); // p in [0,1]
         return std::binomial_distribution<DistributionType>(static_cast<DistributionType>(t), p);
       }
+
+      std::binomial_distribution<DistributionType> aggregate_distribution(
+        const std::binomial_distribution<DistributionType>& d, long long count, aggregate_op op) const {
+        require_sum(op, "binomial");
+        auto t = aggregate_count_param<RasterValueType>(static_cast<RasterValueType>(d.t()), count, "t");
+        return std::binomial_distribution<DistributionType>(static_cast<DistributionType>(t), d.p());
+      }
     };
 
     template <typename RasterValueType>
@@ -297,6 +599,13 @@ namespace pronto {
         auto p = get_required_param<double>(j, "p", { 0.0, true }, { 1.0, true }); // p in [0,1]
         return std::negative_binomial_distribution<DistributionType>(static_cast<DistributionType>(k), p);
       }
+
+      std::negative_binomial_distribution<DistributionType> aggregate_distribution(
+        const std::negative_binomial_distribution<DistributionType>& d, long long count, aggregate_op op) const {
+        require_sum(op, "negative_binomial");
+        auto k = aggregate_count_param<RasterValueType>(static_cast<RasterValueType>(d.k()), count, "k");
+        return std::negative_binomial_distribution<DistributionType>(static_cast<DistributionType>(k), d.p());
+      }
     };
 
     template <typename DistributionType, typename RasterValueType>
@@ -317,6 +626,13 @@ namespace pronto {
         auto mean = get_required_param<double>(j, "mean", { static_cast<double>(0.0), false }); // mean > 0
         return std::poisson_distribution<DistributionType>(mean);
       }
+
+      std::poisson_distribution<DistributionType> aggregate_distribution(
+        const std::poisson_distribution<DistributionType>& d, long long count, aggregate_op op) const {
+        require_sum(op, "poisson");
+        auto mean = aggregate_count_param<RasterValueType>(d.mean(), count, "mean");
+        return std::poisson_distribution<DistributionType>(mean);
+      }
     };
 
     template <typename ValueType>
@@ -340,6 +656,16 @@ namespace pronto {
         auto stddev = get_optional_param<ValueType>(j, "stddev", 1.0, { static_cast<ValueType>(0.0), false }); // stddev > 0
         return std::normal_distribution<ValueType>(mean, stddev);
       }
+
+      std::normal_distribution<ValueType> aggregate_distribution(
+        const std::normal_distribution<ValueType>& d, long long count, aggregate_op op) const {
+        const double n = static_cast<double>(count);
+        if (op == aggregate_op::sum) {
+          return std::normal_distribution<ValueType>(static_cast<ValueType>(d.mean() * n),
+            static_cast<ValueType>(d.stddev() * std::sqrt(n)));
+        }
+        return std::normal_distribution<ValueType>(d.mean(), static_cast<ValueType>(d.stddev() / std::sqrt(n)));
+      }
     };
 
     template <typename ValueType>
@@ -362,6 +688,13 @@ namespace pronto {
         auto beta = get_optional_param<ValueType>(j, "beta", 1.0, { static_cast<ValueType>(0.0), false }); // beta > 0
         return std::gamma_distribution<ValueType>(alpha, beta);
       }
+
+      std::gamma_distribution<ValueType> aggregate_distribution(
+        const std::gamma_distribution<ValueType>& d, long long count, aggregate_op op) const {
+        const double n = static_cast<double>(count);
+        const double beta = op == aggregate_op::sum ? d.beta() : d.beta() / n;
+        return std::gamma_distribution<ValueType>(static_cast<ValueType>(d.alpha() * n), static_cast<ValueType>(beta));
+      }
     };
 
     template <typename ValueType>
@@ -576,19 +909,313 @@ namespace pronto {
       }
     }
 
-    GDALDataset* random_raster_dataset::create_from_json(const nlohmann::json& j) {
+    bool is_spatial_field(distribution_type dt) {
+      return dt == distribution_type::gaussian_random_field || dt == distribution_type::perlin
+        || dt == distribution_type::simplex || dt == distribution_type::fbm || dt == distribution_type::voronoi;
+    }
+
+    std::unique_ptr<block_generator_interface> make_field_block_generator(std::unique_ptr<spatial_field> field,
+      GDALDataType gdt, int rows, int cols, int block_rows, int block_cols)
+    {
+      switch (gdt) {
+      case GDT_Byte:    return std::make_unique<field_block_generator<uint8_t>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_UInt16:  return std::make_unique<field_block_generator<uint16_t>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_Int16:   return std::make_unique<field_block_generator<int16_t>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_UInt32:  return std::make_unique<field_block_generator<uint32_t>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_Int32:   return std::make_unique<field_block_generator<int32_t>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_UInt64:  return std::make_unique<field_block_generator<uint64_t>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_Int64:   return std::make_unique<field_block_generator<int64_t>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_Float32: return std::make_unique<field_block_generator<float>>(std::move(field), rows, cols, block_rows, block_cols);
+      case GDT_Float64: return std::make_unique<field_block_generator<double>>(std::move(field), rows, cols, block_rows, block_cols);
+      default:
+        throw std::runtime_error("Unsupported GDALDataType '" + std::string(GDALGetDataTypeName(gdt)) + "' for spatial fields.");
+      }
+    }
+
+    // Makes the block generator of a spatial field. The values of a field
+    // depend on their neighbours, so they cannot be aggregated, truncated or
+    // sampled from a table, and the field uses its own counter-based noise 
+    // rather than an engine.
+    std::unique_ptr<block_generator_interface> make_field_generator(const nlohmann::json& j, uint64_t stream,
+      distribution_type dt, GDALDataType gdt)
+    {
+      for (const char* key : { "aggregate", "truncation" }) {
+        if (j.contains(key)) {
+          throw std::runtime_error(std::string("Parameter '") + key + "' is not supported for the " 
+            + to_string(dt) + " distribution");
+        }
+      }
+      auto sampling_str = get_optional_param_no_bounds<std::string>(j, "sampling", "direct");
+      if (string_to_sampling_mode(sampling_str) != sampling_mode::direct) {
+        throw std::runtime_error("Sampling " + sampling_str + " is not supported for the " 
+          + to_string(dt) + " distribution");
+      }
+
+      int rows = get_required_param<int>(j, "rows", { 1,true });
+      int cols = get_required_param<int>(j, "cols", { 1,true });
+      long long default_seed_val = std::chrono::system_clock::now().time_since_epoch().count();
+      long long seed = get_optional_param<long long>(j, "seed", default_seed_val);
+      int block_rows = get_optional_param<int>(j, "block_rows", 256, { 1,true });
+      int block_cols = get_optional_param<int>(j, "block_cols", 256, { 1,true });
+
+      auto params = get_required_param_no_bounds<nlohmann::json>(j, "distribution_parameters");
+      std::unique_ptr<spatial_field> field;
+      if (dt == distribution_type::gaussian_random_field) {
+        if (gdt != GDT_Float32 && gdt != GDT_Float64) {
+          throw std::runtime_error("gaussian_random_field requires Float32 or Float64, not "
+            + std::string(GDALGetDataTypeName(gdt)));
+        }
+        double mean = get_optional_param<double>(params, "mean", 0.0);
+        double stddev = get_optional_param<double>(params, "stddev", 1.0, { 0.0, false });
+        auto covariance_str = get_optional_param_no_bounds<std::string>(params, "covariance", "exponential");
+        covariance_model covariance = string_to_covariance_model(covariance_str);
+        double correlation_length = get_required_param<double>(params, "correlation_length", { 0.0, false });
+        double nu = get_optional_param<double>(params, "nu", 1.5, { 0.0, false });
+        field = std::make_unique<gaussian_random_field>(seed, stream, block_rows, block_cols,
+          mean, stddev, covariance, correlation_length, nu);
+      }
+      else if (dt == distribution_type::voronoi) {
+        auto weights = get_required_param_vector<std::vector<double>>(params, "weights");
+        for (const auto& weight : weights) {
+          if (weight < 0.0) {
+            throw std::runtime_error("For voronoi, all weights must be non-negative.");
+          }
+        }
+        double cell_size = get_optional_param<double>(params, "cell_size", 32.0, { 1.0, true });
+        double jitter = get_optional_param<double>(params, "jitter", 1.0, { 0.0, true }, { 1.0, true });
+        field = std::make_unique<voronoi_field>(seed, stream, weights, cell_size, jitter);
+      }
+      else {
+        // perlin and simplex are fbm with a single octave.
+        double mean = get_optional_param<double>(params, "mean", 0.0);
+        double amplitude = get_optional_param<double>(params, "amplitude", 1.0);
+        double scale = get_optional_param<double>(params, "scale", 64.0, { 0.0, false });
+        noise_basis basis = dt == distribution_type::simplex ? noise_basis::simplex : noise_basis::perlin;
+        int octaves = 1;
+        double lacunarity = 2.0;
+        double gain = 0.5;
+        if (dt == distribution_type::fbm) {
+          auto basis_str = get_optional_param_no_bounds<std::string>(params, "basis", "perlin");
+          basis = string_to_noise_basis(basis_str);
+          octaves = get_optional_param<int>(params, "octaves", 6, { 1,true }, { 16,true });
+          lacunarity = get_optional_param<double>(params, "lacunarity", 2.0, { 1.0, false });
+          gain = get_optional_param<double>(params, "gain", 0.5, { 0.0, false });
+        }
+        field = std::make_unique<coherent_noise_field>(seed, stream, rows, cols, basis,
+          mean, amplitude, scale, octaves, lacunarity, gain);
+      }
+      return make_field_block_generator(std::move(field), gdt, rows, cols, block_rows, block_cols);
+    }
+
+    template<typename T>
+    std::unique_ptr<block_generator_interface> make_smoothed_generator(
+      std::unique_ptr<block_generator_interface> noise, smoothing_kernel kernel, int radius,
+      int rows, int cols, int block_rows, int block_cols)
+    {
+      auto field = std::make_unique<smoothed_noise_field<T>>(std::move(noise), kernel, radius);
+      return std::make_unique<field_block_generator<T>>(std::move(field), rows, cols, block_rows, block_cols);
+    }
+
+    // Makes the block generator that smooths the white noise of the band. 
+    // The noise is generated with pixel addressing, so that the halo of a 
+    // block can be regenerated from the pixel seeds.
+    std::unique_ptr<block_generator_interface> make_smoothed_noise_generator(const nlohmann::json& j, 
+      uint64_t stream, distribution_type dt, GDALDataType gdt)
+    {
+      if (is_spatial_field(dt)) {
+        throw std::runtime_error("Parameter 'smoothed_noise' is not supported for the " + to_string(dt) + " distribution");
+      }
+      auto smoothing = get_required_param_no_bounds<nlohmann::json>(j, "smoothed_noise");
+      auto kernel_str = get_optional_param_no_bounds<std::string>(smoothing, "kernel", "gaussian");
+      smoothing_kernel kernel = string_to_smoothing_kernel(kernel_str);
+      int radius = get_required_param<int>(smoothing, "radius", { 1,true }, { 256,true });
+
+      nlohmann::json noise_json = j;
+      noise_json.erase("smoothed_noise");
+      auto addressing_str = get_optional_param_no_bounds<std::string>(noise_json, "addressing", "pixel");
+      if (string_to_addressing_mode(addressing_str) != addressing_mode::pixel) {
+        throw std::runtime_error("Parameter 'smoothed_noise' requires \"addressing\": \"pixel\"");
+      }
+      noise_json["addressing"] = "pixel";
+      std::unique_ptr<block_generator_interface> noise = get_maker(dt, gdt)->make(noise_json, stream);
+
+      int rows = get_required_param<int>(j, "rows", { 1,true });
+      int cols = get_required_param<int>(j, "cols", { 1,true });
+      int block_rows = get_optional_param<int>(j, "block_rows", 256, { 1,true });
+      int block_cols = get_optional_param<int>(j, "block_cols", 256, { 1,true });
+      switch (gdt) {
+      case GDT_Byte:    return make_smoothed_generator<uint8_t>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_UInt16:  return make_smoothed_generator<uint16_t>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_Int16:   return make_smoothed_generator<int16_t>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_UInt32:  return make_smoothed_generator<uint32_t>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_Int32:   return make_smoothed_generator<int32_t>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_UInt64:  return make_smoothed_generator<uint64_t>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_Int64:   return make_smoothed_generator<int64_t>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_Float32: return make_smoothed_generator<float>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      case GDT_Float64: return make_smoothed_generator<double>(std::move(noise), kernel, radius, rows, cols, block_rows, block_cols);
+      default:
+        throw std::runtime_error("Unsupported GDALDataType '" + std::string(GDALGetDataTypeName(gdt)) + "' for smoothed noise.");
+      }
+    }
+
+    // Makes the block generator for one band, the stream keys the random 
+    // engines on the band.
+    std::unique_ptr<block_generator_interface> make_band_generator(const nlohmann::json& j, uint64_t stream,
+      GDALDataType& gdt)
+    {
       auto data_type_str = get_required_param_no_bounds<std::string>(j, "data_type");
-      GDALDataType gdt = GDALGetDataTypeByName(data_type_str.c_str());
+      gdt = GDALGetDataTypeByName(data_type_str.c_str());
       if (gdt == GDT_Unknown) {
         throw std::runtime_error("Unknown or unsupported GDAL data type: " + data_type_str);
       }
 
       auto dist_type_str = get_required_param_no_bounds<std::string>(j, "distribution");
       distribution_type dt = string_to_distribution_type(dist_type_str);
+      if (j.contains("smoothed_noise")) {
+        return make_smoothed_noise_generator(j, stream, dt, gdt);
+      }
+      if (is_spatial_field(dt)) {
+        return make_field_generator(j, stream, dt, gdt);
+      }
 
       std::unique_ptr<maker_base> maker_ptr = get_maker(dt, gdt);
 
-      return maker_ptr->make(j);
+      return maker_ptr->make(j, stream);
+    }
+
+    // Probability that a generated value equals the nodata value, as far as
+    // it is known from the distribution of the values. Real values that are 
+    // converted to an integer data type may become the nodata value if they
+    // are within one of it.
+    double nodata_probability(const value_distribution& values, GDALDataType gdt, double nodata)
+    {
+      if (!values.available()) {
+        return 0.0;
+      }
+      if (values.integer()) {
+        return nodata == std::floor(nodata)
+          ? values.probability_below(nodata + 1.0) - values.probability_below(nodata) : 0.0;
+      }
+      if (GDALDataTypeIsInteger(gdt)) {
+        return values.probability_below(nodata + 1.0) - values.probability_below(nodata - 1.0);
+      }
+      return 0.0;
+    }
+
+    // Wraps the block generator of a band, such that it sets the missing 
+    // cells to the nodata value.
+    std::unique_ptr<block_generator_interface> make_nodata_generator(
+      std::unique_ptr<block_generator_interface> generator, GDALDataType gdt, const nodata_mask& mask,
+      int rows, int cols, int block_rows, int block_cols)
+    {
+      int clamped = FALSE;
+      int rounded = FALSE;
+      GDALAdjustValueToDataType(gdt, mask.value(), &clamped, &rounded);
+      if (clamped || rounded) {
+        throw std::runtime_error("The nodata value " + std::to_string(mask.value()) 
+          + " cannot be represented as " + GDALGetDataTypeName(gdt));
+      }
+      // Generated values that equal the nodata value would be taken as 
+      // missing. Values that are negligibly rare are accepted.
+      if (nodata_probability(generator->get_value_distribution(), gdt, mask.value()) > std::ldexp(1.0, -40)) {
+        throw std::runtime_error("The nodata value " + std::to_string(mask.value())
+          + " can be generated by the distribution, choose a value outside its range");
+      }
+      switch (gdt) {
+      case GDT_Byte:    return std::make_unique<nodata_block_generator<uint8_t>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_UInt16:  return std::make_unique<nodata_block_generator<uint16_t>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_Int16:   return std::make_unique<nodata_block_generator<int16_t>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_UInt32:  return std::make_unique<nodata_block_generator<uint32_t>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_Int32:   return std::make_unique<nodata_block_generator<int32_t>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_UInt64:  return std::make_unique<nodata_block_generator<uint64_t>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_Int64:   return std::make_unique<nodata_block_generator<int64_t>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_Float32: return std::make_unique<nodata_block_generator<float>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      case GDT_Float64: return std::make_unique<nodata_block_generator<double>>(std::move(generator), mask, rows, cols, block_rows, block_cols);
+      default:
+        throw std::runtime_error("Unsupported GDALDataType '" + std::string(GDALGetDataTypeName(gdt)) + "' for nodata.");
+      }
+    }
+
+    std::shared_ptr<const random_raster_definition> random_raster_dataset::definition_from_json(const nlohmann::json& j) {
+      int rows = get_required_param<int>(j, "rows", { 1,true });
+      int cols = get_required_param<int>(j, "cols", { 1,true });
+      int block_rows = get_optional_param<int>(j, "block_rows", 256, { 1,true });
+      int block_cols = get_optional_param<int>(j, "block_cols", 256, { 1,true });
+      auto interleave_str = get_optional_param_no_bounds<std::string>(j, "interleave", "band");
+      if (interleave_str != "band" && interleave_str != "pixel") {
+        throw std::runtime_error(interleave_str + " is not a supported interleave");
+      }
+
+      // The missing cells are the same for all bands.
+      std::unique_ptr<nodata_mask> mask;
+      if (j.contains("nodata")) {
+        auto nodata = get_required_param_no_bounds<nlohmann::json>(j, "nodata");
+        double value = get_required_param_no_bounds<double>(nodata, "value");
+        double probability = get_required_param<double>(nodata, "probability", { 0.0, true }, { 1.0, true });
+        auto pattern_str = get_optional_param_no_bounds<std::string>(nodata, "pattern", "pixel");
+        long long default_seed_val = std::chrono::system_clock::now().time_since_epoch().count();
+        long long seed = get_optional_param<long long>(j, "seed", default_seed_val);
+        mask = std::make_unique<nodata_mask>(seed, value, probability, string_to_nodata_pattern(pattern_str),
+          block_rows, block_cols);
+      }
+
+      std::vector<std::unique_ptr<block_generator_interface>> generators;
+      std::vector<GDALDataType> data_types;
+      if (!j.contains("bands")) {
+        GDALDataType gdt;
+        generators.push_back(make_band_generator(j, 0, gdt));
+        data_types.push_back(gdt);
+      }
+      else {
+        // Each band takes the top-level parameters, overridden by its own.
+        auto bands = get_required_param_no_bounds<nlohmann::json>(j, "bands");
+        if (!bands.is_array() || bands.empty()) {
+          throw std::runtime_error("Parameter 'bands' must be a non-empty array");
+        }
+        for (size_t i = 0; i < bands.size(); ++i) {
+          if (!bands[i].is_object()) {
+            throw std::runtime_error("The elements of 'bands' must be objects");
+          }
+          for (const char* key : { "type", "rows", "cols", "block_rows", "block_cols", "interleave", "nodata", "bands" }) {
+            if (bands[i].contains(key)) {
+              throw std::runtime_error(std::string("Parameter '") + key + "' cannot be set per band");
+            }
+          }
+          nlohmann::json band_json = j;
+          band_json.erase("bands");
+          band_json.update(bands[i]);
+          GDALDataType gdt;
+          generators.push_back(make_band_generator(band_json, i, gdt));
+          data_types.push_back(gdt);
+        }
+      }
+      if (mask) {
+        for (size_t i = 0; i < generators.size(); ++i) {
+          generators[i] = make_nodata_generator(std::move(generators[i]), data_types[i], *mask,
+            rows, cols, block_rows, block_cols);
+        }
+      }
+
+      auto definition = std::make_shared<random_raster_definition>();
+      definition->rows = rows;
+      definition->cols = cols;
+      definition->block_rows = block_rows;
+      definition->block_cols = block_cols;
+      definition->data_types = data_types;
+      for (auto& generator : generators) {
+        definition->block_generators.push_back(std::move(generator));
+      }
+      definition->pixel_interleaved = interleave_str == "pixel";
+      definition->mask = std::move(mask);
+
+      // Without a seed, the seed is taken from the clock.
+      definition->reproducible = j.contains("seed");
+      if (!definition->reproducible && j.contains("bands") && !j.contains("nodata")) {
+        const auto& bands = j["bands"];
+        definition->reproducible = std::all_of(bands.begin(), bands.end(),
+          [](const nlohmann::json& band) { return band.contains("seed"); });
+      }
+      return definition;
     }
   }
-}
+}
\ No newline at end of file
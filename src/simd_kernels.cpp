@@ -0,0 +1,81 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// Baseline SIMD kernels (SSE2 on x86-64, scalar or the native vector
+// instructions elsewhere) and the selection of the best kernels for the CPU.
+
+#define PRONTO_RASTER_KERNEL_ISA baseline
+#include <pronto/raster/simd_kernels_impl.h>
+#undef PRONTO_RASTER_KERNEL_ISA
+
+#if defined(PRONTO_RASTER_X86_DISPATCH) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace pronto {
+  namespace raster {
+
+#ifdef PRONTO_RASTER_X86_DISPATCH
+    namespace avx2 {
+      extern const simd_kernels kernels;
+    }
+    namespace avx512 {
+      extern const simd_kernels kernels;
+    }
+
+    namespace {
+#if defined(_MSC_VER) && !defined(__clang__)
+      // Checks CPUID for the feature bits and XGETBV for the operating
+      // system saving the extended registers.
+      bool cpu_has_avx2()
+      {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const bool os_saves_ymm = (info[2] & (1 << 27)) != 0
+          && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+      }
+
+      bool cpu_has_avx512f()
+      {
+        if (!cpu_has_avx2()) return false;
+        int info[4];
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6;
+      }
+#else
+      bool cpu_has_avx2()
+      {
+        return __builtin_cpu_supports("avx2");
+      }
+
+      bool cpu_has_avx512f()
+      {
+        return __builtin_cpu_supports("avx512f");
+      }
+#endif
+    } // namespace
+#endif
+
+    const simd_kernels& get_simd_kernels()
+    {
+      static const simd_kernels& selected = []() -> const simd_kernels& {
+#ifdef PRONTO_RASTER_X86_DISPATCH
+        if (cpu_has_avx512f()) return avx512::kernels;
+        if (cpu_has_avx2()) return avx2::kernels;
+#endif
+        return baseline::kernels;
+      }();
+      return selected;
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,12 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+// SIMD kernels compiled for AVX-512, see CMakeLists.txt for the flags.
+
+#define PRONTO_RASTER_KERNEL_ISA avx512
+#include <pronto/raster/simd_kernels_impl.h>
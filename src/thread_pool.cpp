@@ -0,0 +1,126 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/thread_pool.h>
+
+namespace pronto {
+  namespace raster {
+
+    thread_pool::thread_pool(int num_threads)
+      : m_ranges(new task_range[num_threads > 1 ? num_threads : 1])
+    {
+      for (int i = 1; i < num_threads; ++i) {
+        m_workers.emplace_back(&thread_pool::worker_loop, this, static_cast<std::size_t>(i));
+      }
+    }
+
+    thread_pool::~thread_pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+      m_start.notify_all();
+      for (std::thread& worker : m_workers) {
+        worker.join();
+      }
+    }
+
+    int thread_pool::num_threads() const
+    {
+      return static_cast<int>(m_workers.size()) + 1;
+    }
+
+    void thread_pool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& task)
+    {
+      if (m_workers.empty() || count < 2) {
+        for (std::size_t i = 0; i < count; ++i) {
+          task(i);
+        }
+        return;
+      }
+
+      std::lock_guard<std::mutex> call_lock(m_call_mutex);
+      const std::size_t participants = m_workers.size() + 1;
+      for (std::size_t p = 0; p < participants; ++p) {
+        std::lock_guard<std::mutex> range_lock(m_ranges[p].mutex);
+        m_ranges[p].begin = count * p / participants;
+        m_ranges[p].end = count * (p + 1) / participants;
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_busy_workers = m_workers.size();
+        ++m_generation;
+      }
+      m_start.notify_all();
+
+      work(0);
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_done.wait(lock, [this] { return m_busy_workers == 0; });
+      m_task = nullptr;
+    }
+
+    void thread_pool::worker_loop(std::size_t participant)
+    {
+      std::size_t seen_generation = 0;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_start.wait(lock, [&] { return m_stop || m_generation != seen_generation; });
+          if (m_stop) {
+            return;
+          }
+          seen_generation = m_generation;
+        }
+
+        work(participant);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busy_workers == 0) {
+          m_done.notify_one();
+        }
+      }
+    }
+
+    void thread_pool::work(std::size_t participant)
+    {
+      std::size_t index;
+      while (next_task(participant, index)) {
+        (*m_task)(index);
+      }
+    }
+
+    // Takes the next task from the front of the own range, or steals one
+    // from the back of the range of another thread.
+    bool thread_pool::next_task(std::size_t participant, std::size_t& index)
+    {
+      {
+        task_range& own = m_ranges[participant];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.begin < own.end) {
+          index = own.begin++;
+          return true;
+        }
+      }
+      const std::size_t participants = m_workers.size() + 1;
+      for (std::size_t i = 1; i < participants; ++i) {
+        task_range& other = m_ranges[(participant + i) % participants];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (other.begin < other.end) {
+          index = --other.end;
+          return true;
+        }
+      }
+      return false;
+    }
+
+  } // namespace raster
+} // namespace pronto
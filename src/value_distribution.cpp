@@ -0,0 +1,146 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/value_distribution.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace pronto {
+  namespace raster {
+
+    value_distribution::value_distribution(std::function<double(double)> cdf, double lower, double upper,
+      double mean, double variance, bool integer)
+      : m_cdf(std::move(cdf))
+      , m_lower(lower)
+      , m_upper(upper)
+      , m_mean(mean)
+      , m_variance(variance)
+      , m_integer(integer)
+    {
+    }
+
+    bool value_distribution::available() const
+    {
+      return static_cast<bool>(m_cdf);
+    }
+
+    bool value_distribution::has_moments() const
+    {
+      return available() && std::isfinite(m_mean) && std::isfinite(m_variance);
+    }
+
+    bool value_distribution::integer() const
+    {
+      return m_integer;
+    }
+
+    double value_distribution::lower() const
+    {
+      return m_lower;
+    }
+
+    double value_distribution::upper() const
+    {
+      return m_upper;
+    }
+
+    double value_distribution::mean() const
+    {
+      return m_mean;
+    }
+
+    double value_distribution::std_dev() const
+    {
+      return std::sqrt(m_variance);
+    }
+
+    double value_distribution::probability_below(double x) const
+    {
+      if (!(x > m_lower)) {
+        return 0.0;
+      }
+      if (x > m_upper) {
+        return 1.0;
+      }
+      const double p = m_integer ? m_cdf(std::ceil(x) - 1.0) : m_cdf(x);
+      return std::clamp(p, 0.0, 1.0);
+    }
+
+    double value_distribution::quantile(double p) const
+    {
+      if (p <= 0.0) return m_lower;
+      if (p >= 1.0) return m_upper;
+
+      // Bracket with cdf(a) < p <= cdf(b), expanding unbounded sides.
+      const double unit = m_integer ? 1.0 : 0.0;
+      double a = std::isfinite(m_lower) ? m_lower - unit : std::min(m_upper, 0.0) - 1.0;
+      for (double step = 1.0; m_cdf(a) >= p; step *= 2.0) {
+        a -= step;
+      }
+      double b = std::isfinite(m_upper) ? m_upper : std::max(a, 0.0) + 1.0;
+      for (double step = 1.0; m_cdf(b) < p; step *= 2.0) {
+        a = b;
+        b += step;
+      }
+
+      for (int iteration = 0; iteration < 200; ++iteration) {
+        double mid = 0.5 * (a + b);
+        if (m_integer) {
+          mid = std::floor(mid);
+        }
+        if (mid <= a || mid >= b) break;
+        if (m_cdf(mid) < p) {
+          a = mid;
+        }
+        else {
+          b = mid;
+        }
+      }
+      return b;
+    }
+
+    double value_distribution::expected_min(uint64_t count) const
+    {
+      return std::isfinite(m_lower) ? m_lower : quantile(1.0 / (static_cast<double>(count) + 1.0));
+    }
+
+    double value_distribution::expected_max(uint64_t count) const
+    {
+      return std::isfinite(m_upper) ? m_upper : quantile(1.0 - 1.0 / (static_cast<double>(count) + 1.0));
+    }
+
+    void value_distribution::histogram(double min, double max, int buckets, bool include_out_of_range,
+      uint64_t count, uint64_t* counts) const
+    {
+      // Rounding the cumulative counts at the bucket edges, rather than the
+      // counts per bucket, keeps the total consistent.
+      const double total = static_cast<double>(count);
+      const double width = (max - min) / buckets;
+      auto cumulative = [&](int edge) {
+        const double x = edge == buckets ? max : min + edge * width;
+        return static_cast<uint64_t>(std::llround(total * probability_below(x)));
+        };
+
+      const uint64_t below = cumulative(0);
+      uint64_t previous = below;
+      for (int i = 0; i < buckets; ++i) {
+        const uint64_t next = std::max(previous, cumulative(i + 1));
+        counts[i] = next - previous;
+        previous = next;
+      }
+      if (include_out_of_range && buckets > 0) {
+        counts[0] += below;
+        counts[buckets - 1] += count - std::min(previous, count);
+      }
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -0,0 +1,123 @@
+//=======================================================================
+// Copyright 2024-2025
+// Author: Alex Hagen-Zanker
+// University of Surrey
+//
+// Distributed under the MIT Licence (http://opensource.org/licenses/MIT)
+//=======================================================================
+//
+
+#include <pronto/raster/distribution_statistics.h>
+#include <pronto/raster/splitmix64.h>
+#include <pronto/raster/voronoi_field.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace pronto {
+  namespace raster {
+
+    voronoi_field::voronoi_field(uint64_t seed, uint64_t stream, const std::vector<double>& weights,
+      double cell_size, double jitter)
+      : m_key(splitmix64::mix(seed ^ splitmix64::mix(stream + 0x564F524F4E4F4921ull)))
+      , m_cell_size(cell_size)
+      , m_jitter(jitter)
+    {
+      double total = 0.0;
+      for (double weight : weights) {
+        total += weight;
+      }
+      if (weights.empty() || !(total > 0.0)) {
+        throw std::runtime_error("For voronoi, the weights must not be empty and not all zero.");
+      }
+      double sum = 0.0;
+      for (double weight : weights) {
+        sum += weight;
+        m_cumulative.push_back(sum / total);
+      }
+      m_cumulative.back() = 1.0;
+
+      // The classes of the seed points are independent of the geometry, so 
+      // every cell has the discrete distribution of the weights.
+      using statistics = distribution_statistics<std::discrete_distribution<int>>;
+      const std::discrete_distribution<int> classes(weights.begin(), weights.end());
+      auto cdf = [classes](double x) { return statistics::cdf(classes, x); };
+      m_values = value_distribution(cdf, statistics::lower(classes), statistics::upper(classes),
+        statistics::mean(classes), statistics::variance(classes), true);
+    }
+
+    voronoi_field::seed_point voronoi_field::point_of(int64_t grid_row, int64_t grid_col) const
+    {
+      const uint64_t position = (static_cast<uint64_t>(static_cast<uint32_t>(grid_row)) << 32)
+        | static_cast<uint32_t>(grid_col);
+      const uint64_t first = splitmix64::mix(m_key + splitmix64::mix(position));
+      const uint64_t second = splitmix64::mix(first + 0x9E3779B97F4A7C15ull);
+      const uint64_t third = splitmix64::mix(second + 0x9E3779B97F4A7C15ull);
+      const double u = std::ldexp(static_cast<double>(first >> 11), -53);
+      const double v = std::ldexp(static_cast<double>(second >> 11), -53);
+      const double w = std::ldexp(static_cast<double>(third >> 11), -53);
+
+      seed_point point;
+      point.row = (static_cast<double>(grid_row) + 0.5 + m_jitter * (u - 0.5)) * m_cell_size;
+      point.col = (static_cast<double>(grid_col) + 0.5 + m_jitter * (v - 0.5)) * m_cell_size;
+      point.value = static_cast<double>(std::upper_bound(m_cumulative.begin(), m_cumulative.end() - 1, w)
+        - m_cumulative.begin());
+      return point;
+    }
+
+    void voronoi_field::generate(int first_row, int first_col, int rows, int cols, double* values,
+      std::ptrdiff_t line_stride) const
+    {
+      // The seed points of the grid cells around the window.
+      auto grid_of = [this](int cell) { return static_cast<int64_t>(std::floor((cell + 0.5) / m_cell_size)); };
+      const int64_t grid_row_begin = grid_of(first_row) - 2;
+      const int64_t grid_col_begin = grid_of(first_col) - 2;
+      const int64_t grid_rows = grid_of(first_row + rows - 1) + 3 - grid_row_begin;
+      const int64_t grid_cols = grid_of(first_col + cols - 1) + 3 - grid_col_begin;
+      std::vector<seed_point> points(static_cast<std::size_t>(grid_rows * grid_cols));
+      for (int64_t i = 0; i < grid_rows; ++i) {
+        for (int64_t j = 0; j < grid_cols; ++j) {
+          points[i * grid_cols + j] = point_of(grid_row_begin + i, grid_col_begin + j);
+        }
+      }
+
+      for (int r = 0; r < rows; ++r) {
+        const double y = first_row + r + 0.5;
+        const int64_t grid_row = grid_of(first_row + r) - grid_row_begin;
+        double* target = values + r * line_stride;
+        for (int c = 0; c < cols; ++c) {
+          const double x = first_col + c + 0.5;
+          const int64_t grid_col = grid_of(first_col + c) - grid_col_begin;
+          double nearest = std::numeric_limits<double>::infinity();
+          double value = 0.0;
+          for (int di = -2; di <= 2; ++di) {
+            for (int dj = -2; dj <= 2; ++dj) {
+              if ((di == -2 || di == 2) && (dj == -2 || dj == 2)) continue;
+              const seed_point& point = points[(grid_row + di) * grid_cols + grid_col + dj];
+              const double distance = (point.row - y) * (point.row - y) + (point.col - x) * (point.col - x);
+              if (distance < nearest) {
+                nearest = distance;
+                value = point.value;
+              }
+            }
+          }
+          target[c] = value;
+        }
+      }
+    }
+
+    bool voronoi_field::pixel_addressable() const
+    {
+      return true;
+    }
+
+    const value_distribution& voronoi_field::get_value_distribution() const
+    {
+      return m_values;
+    }
+
+  } // namespace raster
+} // namespace pronto
@@ -1,5 +1,7 @@
+import json
 import os
 import sys
+import numpy as np
 import pytest
 from osgeo import gdal
 
@@ -9,9 +11,9 @@ def check_gdal_driver_path():
     driver_path = os.environ.get('GDAL_DRIVER_PATH')
     if not driver_path:
         pytest.fail("The GDAL_DRIVER_PATH environment variable is not set.")
-    
+
     print(f"GDAL_DRIVER_PATH is set to: {driver_path}")
-    
+
     if not os.path.isdir(driver_path):
         pytest.fail(f"The directory specified by GDAL_DRIVER_PATH does not exist: {driver_path}")
 
@@ -25,4 +27,65 @@ def register_gdal_driver():
 @pytest.fixture(scope="session", autouse=True)
 def gdal_error_handler():
     """Sets GDAL error handling to not use exceptions for the entire test session."""
-    gdal.DontUseExceptions()
\ No newline at end of file
+    gdal.DontUseExceptions()
+
+@pytest.fixture
+def open_config():
+    """Opens a RANDOM_RASTER dataset from a JSON configuration, through a
+    virtual file that is removed once the dataset is open. Statistics left
+    in an .aux.xml file by an earlier dataset of the same name are removed
+    first."""
+    def open_config(config, vsi_filename="/vsimem/random_raster.json", open_options=None):
+        if gdal.VSIStatL(vsi_filename + ".aux.xml") is not None:
+            gdal.Unlink(vsi_filename + ".aux.xml")
+        gdal.FileFromMemBuffer(vsi_filename, json.dumps(config).encode('utf-8'))
+        ds = gdal.OpenEx(vsi_filename, gdal.OF_RASTER, open_options=open_options or [])
+        gdal.Unlink(vsi_filename)
+        return ds
+    return open_config
+
+@pytest.fixture
+def base_config():
+    """Provides the configuration of a single band raster, generated with
+    the philox4x64 engine so that it can be read with block and pixel
+    addressing. Keyword arguments add or override top-level parameters."""
+    def base_config(distribution, parameters, data_type, rows, cols, block_rows, block_cols, seed, **extra):
+        config = {
+            "type": "RANDOM_RASTER",
+            "rows": rows,
+            "cols": cols,
+            "data_type": data_type,
+            "seed": seed,
+            "block_rows": block_rows,
+            "block_cols": block_cols,
+            "engine": "philox4x64",
+            "distribution": distribution,
+            "distribution_parameters": parameters
+        }
+        config.update(extra)
+        return config
+    return base_config
+
+@pytest.fixture
+def read_by_blocks():
+    """Assembles the raster of a band from ReadBlock, which does not use
+    RasterIO."""
+    def read_by_blocks(band):
+        block_cols, block_rows = band.GetBlockSize()
+        data = np.zeros((band.YSize, band.XSize), dtype=band.ReadAsArray(0, 0, 1, 1).dtype)
+        for i in range((band.YSize + block_rows - 1) // block_rows):
+            for j in range((band.XSize + block_cols - 1) // block_cols):
+                block = np.frombuffer(band.ReadBlock(j, i), dtype=data.dtype).reshape(block_rows, block_cols)
+                rows = min(block_rows, band.YSize - i * block_rows)
+                cols = min(block_cols, band.XSize - j * block_cols)
+                data[i * block_rows:i * block_rows + rows, j * block_cols:j * block_cols + cols] = block[:rows, :cols]
+        return data
+    return read_by_blocks
+
+@pytest.fixture
+def nearest():
+    """Provides the indices of the cells of a dimension of full_size that
+    are nearest to the centres of the cells of an overview of size."""
+    def nearest(full_size, size):
+        return np.minimum(full_size - 1, ((np.arange(size) + 0.5) * full_size / size).astype(int))
+    return nearest
@@ -0,0 +1,57 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+@pytest.fixture
+def advise_json(base_config):
+    """Provides configurations of a raster of 8 x 7 blocks, the last row
+    and column partial, so that advised windows cover inner and edge
+    blocks."""
+    def advise_json(addressing="block"):
+        return base_config("uniform_real", {"a": 0.0, "b": 10.0}, "Float32", rows=300, cols=200,
+                           block_rows=40, block_cols=30, seed=11, addressing=addressing)
+    return advise_json
+
+@pytest.mark.parametrize("addressing", ["block", "pixel"])
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_advised_window_is_bit_identical(open_config, advise_json, addressing, num_threads):
+    """Reads from an advised window should equal reads without advice."""
+    config = advise_json(addressing)
+    expected = open_config(config, "/vsimem/plain.json").GetRasterBand(1).ReadAsArray()
+    band = open_config(config, "/vsimem/advised.json", ["NUM_THREADS=" + num_threads]).GetRasterBand(1)
+    assert band.AdviseRead(25, 35, 150, 200) == gdal.CE_None
+    assert np.array_equal(band.ReadAsArray(25, 35, 150, 200), expected[35:235, 25:175])
+    assert np.array_equal(band.ReadAsArray(60, 80, 31, 17), expected[80:97, 60:91])
+    # Partly outside of the advised window
+    assert np.array_equal(band.ReadAsArray(0, 0, 200, 300), expected)
+
+def test_advised_blocks(open_config, advise_json):
+    """Blocks inside the advised window are read from it, including edge blocks."""
+    config = advise_json()
+    plain = open_config(config, "/vsimem/plain.json").GetRasterBand(1)
+    band = open_config(config, "/vsimem/blocks.json").GetRasterBand(1)
+    assert band.AdviseRead(0, 0, 200, 300) == gdal.CE_None
+    for i, j in [(0, 0), (3, 2), (7, 6), (7, 0), (0, 6)]:
+        assert band.ReadBlock(j, i) == plain.ReadBlock(j, i)
+
+def test_advised_buffer_type(open_config, advise_json):
+    """A window advised in another data type is used for reads in that type."""
+    config = advise_json()
+    expected = open_config(config, "/vsimem/plain.json").GetRasterBand(1).ReadAsArray()
+    ds = open_config(config, "/vsimem/typed.json")
+    assert ds.AdviseRead(10, 20, 100, 100, buf_type=gdal.GDT_Float64) == gdal.CE_None
+    window = ds.GetRasterBand(1).ReadAsArray(10, 20, 100, 100, buf_type=gdal.GDT_Float64)
+    assert window.dtype == np.float64
+    assert np.array_equal(window, expected[20:120, 10:110].astype(np.float64))
+    # A read in the native type is not served from the staged window
+    assert np.array_equal(ds.GetRasterBand(1).ReadAsArray(10, 20, 100, 100), expected[20:120, 10:110])
+
+def test_advise_replaced(open_config, advise_json):
+    """A new AdviseRead replaces the staged window."""
+    config = advise_json()
+    expected = open_config(config, "/vsimem/plain.json").GetRasterBand(1).ReadAsArray()
+    band = open_config(config, "/vsimem/replaced.json").GetRasterBand(1)
+    band.AdviseRead(0, 0, 50, 50)
+    band.AdviseRead(100, 100, 50, 50)
+    assert np.array_equal(band.ReadAsArray(0, 0, 50, 50), expected[0:50, 0:50])
+    assert np.array_equal(band.ReadAsArray(100, 100, 50, 50), expected[100:150, 100:150])
@@ -0,0 +1,78 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+def aggregate_json(distribution, parameters, data_type, factor, op="sum"):
+    """Provides a configuration aggregating factor x factor fine cells."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 200,
+        "cols": 200,
+        "data_type": data_type,
+        "seed": 2024,
+        "engine": "philox4x64",
+        "distribution": distribution,
+        "distribution_parameters": parameters,
+        "aggregate": {"factor": factor, "op": op}
+    }
+
+def read_array(ds):
+    return None if ds is None else ds.GetRasterBand(1).ReadAsArray().astype(np.float64)
+
+# (distribution, parameters, data type, op, mean and variance of one fine cell)
+CASES = [
+    ("poisson", {"mean": 0.3}, "Int32", "sum", 0.3, 0.3),
+    ("binomial", {"t": 5, "p": 0.2}, "Int32", "sum", 1.0, 0.8),
+    ("negative_binomial", {"k": 2, "p": 0.5}, "Int32", "sum", 2.0, 4.0),
+    ("normal", {"mean": 1.0, "stddev": 2.0}, "Float64", "sum", 1.0, 4.0),
+    ("gamma", {"alpha": 0.5, "beta": 3.0}, "Float64", "sum", 1.5, 4.5),
+]
+
+@pytest.mark.parametrize("distribution,parameters,data_type,op,mean,variance", CASES)
+def test_aggregate_sum_moments(open_config, distribution, parameters, data_type, op, mean, variance):
+    """The sum of n fine cells has n times the mean and variance of a cell."""
+    n = 10 * 10
+    data = read_array(open_config(aggregate_json(distribution, parameters, data_type, 10, op), "/vsimem/sum.json"))
+    assert data is not None
+    count = data.size
+    assert abs(np.mean(data) - n * mean) < 5 * np.sqrt(n * variance / count)
+    assert abs(np.var(data) / (n * variance) - 1.0) < 0.05
+
+@pytest.mark.parametrize("distribution,parameters", [
+    ("normal", {"mean": 1.0, "stddev": 2.0}),
+    ("gamma", {"alpha": 0.5, "beta": 3.0}),
+])
+def test_aggregate_mean_moments(open_config, distribution, parameters):
+    """The mean of n fine cells keeps the mean and divides the variance by n."""
+    n = 20 * 20
+    data = read_array(open_config(aggregate_json(distribution, parameters, "Float64", 20, "mean"), "/vsimem/mean.json"))
+    mean, variance = (1.0, 4.0) if distribution == "normal" else (1.5, 4.5)
+    assert abs(np.mean(data) - mean) < 5 * np.sqrt(variance / n / data.size)
+    assert abs(np.var(data) / (variance / n) - 1.0) < 0.05
+
+def test_aggregate_factor_one(open_config):
+    """A factor of one leaves the raster unchanged."""
+    config = aggregate_json("poisson", {"mean": 2.5}, "Int32", 1)
+    aggregated = read_array(open_config(config, "/vsimem/one.json"))
+    del config["aggregate"]
+    assert np.array_equal(aggregated, read_array(open_config(config, "/vsimem/plain.json")))
+
+@pytest.mark.parametrize("config_change,message", [
+    ({"distribution": "uniform_real", "data_type": "Float64", "distribution_parameters": {}},
+     "Parameter 'aggregate' is only supported"),
+    ({"aggregate": {"factor": 4, "op": "mean"}}, "Aggregate op 'mean' is not supported"),
+    ({"aggregate": {"factor": 4, "op": "max"}}, "not a supported aggregate op"),
+    ({"aggregate": {"factor": 0}}, "Parameter 'factor'"),
+    ({"distribution": "binomial", "data_type": "Byte", "distribution_parameters": {"t": 20, "p": 0.5}},
+     "exceeds the range of the data type"),
+    ({"data_type": "Byte", "distribution_parameters": {"mean": 20.0}}, "exceeds the range of the data type"),
+])
+def test_aggregate_errors(open_config, config_change, message):
+    """Unsupported aggregations are reported as errors."""
+    config = aggregate_json("poisson", {"mean": 1.0}, "Int32", 4)
+    config.update(config_change)
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        data = read_array(open_config(config, "/vsimem/aggregate_error.json"))
+    assert data is None
+    assert message in gdal.GetLastErrorMsg()
@@ -0,0 +1,75 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+def bands_json(interleave="band"):
+    """Provides a three band configuration with block sizes that do not divide the raster."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 60,
+        "cols": 50,
+        "data_type": "Float32",
+        "seed": 77,
+        "block_rows": 16,
+        "block_cols": 20,
+        "engine": "philox4x64",
+        "interleave": interleave,
+        "distribution": "normal",
+        "distribution_parameters": {"mean": 0.0, "stddev": 1.0},
+        "bands": [
+            {},
+            {},
+            {"data_type": "Byte", "distribution": "uniform_integer",
+             "distribution_parameters": {"a": 1, "b": 6}}
+        ]
+    }
+
+def test_bands_types_and_streams(open_config):
+    """Bands take the top-level parameters, with their own overrides and streams."""
+    config = bands_json()
+    ds = open_config(config, "/vsimem/bands.json")
+    assert ds.RasterCount == 3
+    assert [ds.GetRasterBand(i).DataType for i in (1, 2, 3)] == [gdal.GDT_Float32, gdal.GDT_Float32, gdal.GDT_Byte]
+
+    single = dict(config)
+    del single["bands"]
+    first = open_config(single, "/vsimem/single.json").GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(ds.GetRasterBand(1).ReadAsArray(), first)
+    assert not np.array_equal(ds.GetRasterBand(2).ReadAsArray(), first)
+
+    dice = ds.GetRasterBand(3).ReadAsArray()
+    assert dice.min() == 1 and dice.max() == 6
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_bands_dataset_read(open_config, num_threads):
+    """Multi-band reads into band and pixel interleaved buffers should equal the bands."""
+    ds = open_config(bands_json(), "/vsimem/bands.json", ["NUM_THREADS=" + num_threads])
+    expected = [ds.GetRasterBand(i).ReadAsArray(3, 5, 41, 50).astype(np.float64) for i in (1, 2, 3)]
+
+    band_interleaved = ds.ReadAsArray(3, 5, 41, 50, buf_type=gdal.GDT_Float64)
+    for i in range(3):
+        assert np.array_equal(band_interleaved[i], expected[i])
+
+    buffer = ds.ReadRaster(3, 5, 41, 50, buf_type=gdal.GDT_Float64,
+                           buf_pixel_space=24, buf_line_space=24 * 41, buf_band_space=8)
+    pixel_interleaved = np.frombuffer(buffer, dtype=np.float64).reshape(50, 41, 3)
+    for i in range(3):
+        assert np.array_equal(pixel_interleaved[:, :, i], expected[i])
+
+def test_bands_pixel_interleave(open_config, read_by_blocks):
+    """Block reads with pixel interleave should have the same values as with band interleave."""
+    pixel = open_config(bands_json("pixel"), "/vsimem/pixel.json")
+    band = open_config(bands_json("band"), "/vsimem/band.json")
+    assert pixel.GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE") == "PIXEL"
+    assert band.GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE") == "BAND"
+    for i in (1, 2, 3):
+        assert np.array_equal(read_by_blocks(pixel.GetRasterBand(i)), read_by_blocks(band.GetRasterBand(i)))
+
+@pytest.mark.parametrize("bands", [[], [{"rows": 10}], [{"interleave": "pixel"}], ["normal"]])
+def test_bands_invalid(open_config, bands):
+    """Empty arrays, non-objects and dataset level parameters in a band should fail to open."""
+    config = bands_json()
+    config["bands"] = bands
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/invalid.json")
+    assert ds is None
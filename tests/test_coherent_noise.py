@@ -0,0 +1,71 @@
+import numpy as np
+import pytest
+
+def noise_config(distribution, block_size=64, data_type="Float64", rows=300, cols=200, **parameters):
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": rows,
+        "cols": cols,
+        "block_rows": block_size,
+        "block_cols": block_size,
+        "data_type": data_type,
+        "seed": 3,
+        "distribution": distribution,
+        "distribution_parameters": parameters
+    }
+
+@pytest.mark.parametrize("distribution", ["perlin", "simplex", "fbm"])
+def test_noise_range_and_smoothness(open_config, distribution):
+    ds = open_config(noise_config(distribution, mean=100.0, amplitude=20.0, scale=32.0), "/vsimem/noise.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert data.min() >= 80.0 and data.max() <= 120.0
+    assert data.std() > 1.0
+    # Neighbouring cells are strongly correlated.
+    centered = data - data.mean()
+    assert np.mean(centered[:, :-1] * centered[:, 1:]) / centered.var() > 0.9
+
+@pytest.mark.parametrize("distribution", ["perlin", "simplex", "fbm"])
+def test_noise_does_not_depend_on_blocks_or_windows(open_config, distribution):
+    a = open_config(noise_config(distribution, 64), "/vsimem/a.json").GetRasterBand(1)
+    b = open_config(noise_config(distribution, 50), "/vsimem/b.json").GetRasterBand(1)
+    full = a.ReadAsArray()
+    assert np.array_equal(full, b.ReadAsArray())
+    assert np.array_equal(a.ReadAsArray(13, 71, 40, 9), full[71:80, 13:53])
+
+def test_noise_overviews(open_config, nearest):
+    """Overview pixels are the nearest pixels of the base band."""
+    band = open_config(noise_config("fbm", 32), "/vsimem/overviews.json").GetRasterBand(1)
+    assert band.GetOverviewCount() > 0
+    full = band.ReadAsArray()
+    for i in range(band.GetOverviewCount()):
+        overview = band.GetOverview(i)
+        expected = full[np.ix_(nearest(300, overview.YSize), nearest(200, overview.XSize))]
+        assert np.array_equal(overview.ReadAsArray(), expected)
+
+def test_fbm_parameters(open_config):
+    """More octaves add detail, a single octave is perlin noise."""
+    one = open_config(noise_config("fbm", octaves=1), "/vsimem/one.json").GetRasterBand(1).ReadAsArray()
+    many = open_config(noise_config("fbm", octaves=8, gain=0.7), "/vsimem/many.json").GetRasterBand(1).ReadAsArray()
+    assert np.abs(np.diff(many, axis=1)).mean() > 2.0 * np.abs(np.diff(one, axis=1)).mean()
+
+    base = noise_config("perlin")
+    base["distribution_parameters"] = {}
+    single = open_config(base, "/vsimem/perlin.json").GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(single, one)
+
+def test_integer_elevation_model(open_config):
+    config = noise_config("fbm", data_type="Int16", mean=1000.0, amplitude=500.0, scale=100.0)
+    ds = open_config(config, "/vsimem/dem.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert data.dtype == np.int16
+    assert data.min() >= 500 and data.max() <= 1500
+
+@pytest.mark.parametrize("parameters", [{"scale": 0.0}, {"octaves": 17}, {"lacunarity": 1.0}, {"basis": "value"}])
+def test_invalid_parameters(open_config, parameters):
+    assert open_config(noise_config("fbm", **parameters), "/vsimem/invalid.json") is None
+
+def test_raster_too_large_for_the_lattice(open_config):
+    config = noise_config("fbm", rows=2000000000, cols=10, scale=1.0, octaves=16)
+    assert open_config(config, "/vsimem/too_large.json") is None
@@ -0,0 +1,101 @@
+import json
+import numpy as np
+import pytest
+from osgeo import gdal
+
+def moments_json(distribution, parameters, data_type):
+    """Provides a configuration of many small blocks, with partial blocks at the edges."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 300,
+        "cols": 250,
+        "data_type": data_type,
+        "seed": 99,
+        "block_rows": 32,
+        "block_cols": 48,
+        "engine": "philox4x64",
+        "distribution": distribution,
+        "distribution_parameters": parameters
+    }
+
+CASES = [
+    ("normal", {"mean": 1000.0, "stddev": 2.0}, "Float64"),
+    ("gamma", {"alpha": 0.5, "beta": 2.0}, "Float32"),
+    ("poisson", {"mean": 3.0}, "Int32"),
+    ("uniform_integer", {"a": 0, "b": 255}, "Byte"),
+]
+
+def assert_sample_statistics(statistics, data):
+    minimum, maximum, mean, stddev = statistics
+    assert minimum == data.min()
+    assert maximum == data.max()
+    assert mean == pytest.approx(data.mean(), rel=1e-12, abs=1e-12)
+    assert stddev == pytest.approx(data.std(), rel=1e-9)
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("distribution,parameters,data_type", CASES)
+def test_compute_statistics_exact(open_config, num_threads, distribution, parameters, data_type):
+    """ComputeStatistics should give the statistics of the generated values, on any number of threads."""
+    config = moments_json(distribution, parameters, data_type)
+    band = open_config(config, "/vsimem/moments.json", [f"NUM_THREADS={num_threads}"]).GetRasterBand(1)
+    statistics = band.ComputeStatistics(False)
+    data = open_config(config, "/vsimem/data.json").GetRasterBand(1).ReadAsArray().astype(np.float64)
+    assert_sample_statistics(statistics, data)
+    assert float(band.GetMetadataItem("STATISTICS_VALID_PERCENT")) == 100.0
+    assert band.ComputeRasterMinMax(False) == (data.min(), data.max())
+
+def test_compute_statistics_progress(open_config):
+    """Progress is reported per row of blocks, and cancelling it fails the computation."""
+    band = open_config(moments_json("normal", {"mean": 0.0, "stddev": 1.0}, "Float64")).GetRasterBand(1)
+    reported = []
+    band.ComputeStatistics(False, callback=lambda complete, message, data: reported.append(complete) or 1)
+    assert reported == sorted(reported)
+    assert len(reported) >= 300 // 32
+    assert reported[-1] == 1.0
+
+    band = open_config(moments_json("normal", {"mean": 0.0, "stddev": 1.0}, "Float64")).GetRasterBand(1)
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        result = band.ComputeStatistics(False, callback=lambda complete, message, data: complete < 0.5)
+    assert result is None or result == [0.0, 0.0, 0.0, -1.0]
+    assert gdal.GetLastErrorType() == gdal.CE_Failure
+
+def test_approximate_statistics_from_overview(open_config):
+    """Approximate statistics of a band with overviews do not generate the full raster."""
+    config = moments_json("normal", {"mean": 5.0, "stddev": 2.0}, "Float32")
+    config.update({"rows": 100000, "cols": 100000, "block_rows": 256, "block_cols": 256, "addressing": "pixel"})
+    band = open_config(config, "/vsimem/approximate.json").GetRasterBand(1)
+    assert band.GetOverviewCount() > 0
+    minimum, maximum, mean, stddev = band.ComputeStatistics(True)
+    assert mean == pytest.approx(5.0, abs=0.2)
+    assert stddev == pytest.approx(2.0, abs=0.2)
+    assert band.GetMetadataItem("STATISTICS_APPROXIMATE") == "YES"
+
+def test_statistics_after_full_read(open_config):
+    """Once all blocks have been read, GetStatistics should give the sample statistics."""
+    config = moments_json("normal", {"mean": 0.0, "stddev": 1.0}, "Float64")
+    band = open_config(config, "/vsimem/moments.json").GetRasterBand(1)
+    analytic = band.GetStatistics(False, True)
+    assert analytic[2:] == [0.0, 1.0]
+
+    # Reading only part of the blocks does not change the statistics
+    band.ReadAsArray(0, 0, 100, 100)
+    assert band.GetStatistics(False, True) == analytic
+
+    data = band.ReadAsArray()
+    assert_sample_statistics(band.GetStatistics(False, True), data)
+
+def test_statistics_persisted(open_config):
+    """Computed statistics should be saved with the dataset and used when it is opened again."""
+    config = moments_json("normal", {"mean": 0.0, "stddev": 1.0}, "Float64")
+    ds = open_config(config, "/vsimem/persisted.json")
+    statistics = ds.GetRasterBand(1).ComputeStatistics(False)
+    ds = None
+    assert gdal.VSIStatL("/vsimem/persisted.json.aux.xml") is not None
+
+    gdal.FileFromMemBuffer("/vsimem/persisted.json", json.dumps(config).encode('utf-8'))
+    ds = gdal.Open("/vsimem/persisted.json")
+    assert ds.GetRasterBand(1).GetStatistics(False, False) == pytest.approx(statistics)
+    ds = None
+    gdal.Unlink("/vsimem/persisted.json")
+    gdal.Unlink("/vsimem/persisted.json.aux.xml")
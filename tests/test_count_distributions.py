@@ -0,0 +1,51 @@
+import numpy as np
+import pytest
+
+def count_json(distribution, parameters):
+    """Provides a configuration for a count distribution."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 600,
+        "cols": 500,
+        "data_type": "Int32",
+        "seed": 31,
+        "block_rows": 100,
+        "block_cols": 100,
+        "distribution": distribution,
+        "distribution_parameters": parameters
+    }
+
+@pytest.mark.parametrize("distribution,parameters,mean,variance", [
+    ("poisson", {"mean": 0.3}, 0.3, 0.3),
+    ("poisson", {"mean": 4.0}, 4.0, 4.0),
+    ("poisson", {"mean": 29.5}, 29.5, 29.5),
+    ("poisson", {"mean": 100000.0}, 100000.0, 100000.0),
+    ("binomial", {"t": 10, "p": 0.3}, 3.0, 2.1),
+    ("binomial", {"t": 100000, "p": 0.5}, 50000.0, 25000.0),
+    ("geometric", {"p": 0.3}, 0.7 / 0.3, 0.7 / 0.09),
+    ("geometric", {"p": 0.0001}, 9999.0, 0.9999 / 1e-8),
+    ("negative_binomial", {"k": 3, "p": 0.4}, 4.5, 11.25),
+    ("negative_binomial", {"k": 1, "p": 0.2}, 4.0, 20.0)])
+def test_count_moments(open_config, distribution, parameters, mean, variance):
+    """The count distributions should have the expected mean and variance."""
+    ds = open_config(count_json(distribution, parameters), "/vsimem/count.json")
+    assert ds is not None, "GDAL could not open the dataset from the virtual file."
+    data = ds.GetRasterBand(1).ReadAsArray().astype(np.float64)
+    assert data.min() >= 0
+    # Tolerances of about six standard errors
+    assert abs(data.mean() - mean) < 6 * np.sqrt(variance / data.size) + 1e-9
+    assert abs(data.var() / variance - 1.0) < 0.03
+
+def test_poisson_frequencies(open_config):
+    """Small Poisson counts should have the exact probabilities."""
+    data = open_config(count_json("poisson", {"mean": 2.0}), "/vsimem/count_poisson.json").GetRasterBand(1).ReadAsArray()
+    counts = np.bincount(data.ravel())
+    k = np.arange(8)
+    factorials = np.array([1, 1, 2, 6, 24, 120, 720, 5040])
+    expected = np.exp(-2.0) * 2.0 ** k / factorials * data.size
+    assert np.all(np.abs(counts[:8] - expected) < 6 * np.sqrt(expected))
+
+def test_binomial_certain(open_config):
+    """A binomial with p = 1 always gives t."""
+    data = open_config(count_json("binomial", {"t": 7, "p": 1.0}), "/vsimem/count_certain.json").GetRasterBand(1).ReadAsArray()
+    assert np.all(data == 7)
@@ -0,0 +1,56 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+@pytest.fixture
+def discrete_json():
+    """Provides a discrete configuration with many classes."""
+    weights = [float((i % 7) + (0.5 if i % 3 else 0.0)) for i in range(300)]
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 1000,
+        "cols": 1000,
+        "data_type": "UInt16",
+        "seed": 77,
+        "block_rows": 128,
+        "block_cols": 128,
+        "distribution": "discrete",
+        "distribution_parameters": {
+            "weights": weights
+        }
+    }
+
+@pytest.mark.parametrize("engine", ["mt19937_64", "philox4x64"])
+def test_discrete_frequencies(open_config, discrete_json, engine):
+    """Class frequencies should follow the weights, zero weights never occur."""
+    discrete_json["engine"] = engine
+    ds = open_config(discrete_json, "/vsimem/discrete.json")
+    assert ds is not None, "GDAL could not open the dataset from the virtual file."
+    data = ds.GetRasterBand(1).ReadAsArray()
+
+    weights = np.array(discrete_json["distribution_parameters"]["weights"])
+    probabilities = weights / weights.sum()
+    counts = np.bincount(data.ravel(), minlength=len(weights))
+    assert len(counts) == len(weights)
+    assert np.all(counts[probabilities == 0] == 0)
+
+    expected = probabilities * data.size
+    used = expected > 0
+    chi_squared = np.sum((counts[used] - expected[used]) ** 2 / expected[used])
+    degrees = np.count_nonzero(used) - 1
+    assert abs(chi_squared - degrees) < 6 * np.sqrt(2 * degrees)
+
+def test_discrete_single_weight(open_config, discrete_json):
+    """A single weight always gives class 0."""
+    discrete_json["distribution_parameters"]["weights"] = [3.0]
+    data = open_config(discrete_json, "/vsimem/discrete_single.json").GetRasterBand(1).ReadAsArray()
+    assert np.all(data == 0)
+
+def test_discrete_negative_weight(open_config, discrete_json):
+    """Negative weights are reported as an error."""
+    discrete_json["distribution_parameters"]["weights"] = [1.0, -1.0]
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(discrete_json, "/vsimem/discrete_negative.json")
+    assert ds is None
+    assert "non-negative" in gdal.GetLastErrorMsg()
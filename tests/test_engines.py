@@ -0,0 +1,65 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+ENGINES = ["mt19937_64", "philox4x64", "threefry4x64", "xoshiro256++", "pcg64"]
+
+def engine_json(engine):
+    """Provides a uniform integer configuration using the given engine."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 100,
+        "cols": 70,
+        "data_type": "Int32",
+        "seed": 2024,
+        "block_rows": 32,
+        "block_cols": 16,
+        "engine": engine,
+        "distribution": "uniform_integer",
+        "distribution_parameters": {
+            "a": -1000,
+            "b": 1000
+        }
+    }
+
+@pytest.mark.parametrize("engine", ENGINES)
+def test_engine_range_and_reproducibility(open_config, engine):
+    """Verify that every engine produces values in range, reproducibly."""
+    config = engine_json(engine)
+    ds = open_config(config, "/vsimem/engine.json")
+    assert ds is not None, f"GDAL could not open the dataset with engine {engine}."
+
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert np.all(data >= -1000)
+    assert np.all(data <= 1000)
+    assert len(np.unique(data)) > 100
+
+    ds2 = open_config(config, "/vsimem/engine2.json")
+    data2 = ds2.GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(data, data2), "Data should be reproducible with the same seed."
+
+@pytest.mark.parametrize("engine", ENGINES)
+def test_engine_blocks_are_independent(open_config, engine):
+    """A block read on its own must equal the same block read as part of the full raster."""
+    config = engine_json(engine)
+    full = open_config(config, "/vsimem/engine_full.json").GetRasterBand(1).ReadAsArray()
+
+    ds = open_config(config, "/vsimem/engine_block.json")
+    block = ds.GetRasterBand(1).ReadAsArray(16 * 3, 32 * 2, 16, 32)
+    assert np.array_equal(block, full[64:96, 48:64])
+    assert not np.array_equal(block, full[64:96, 32:48]), "Neighbouring blocks should differ."
+
+def test_engines_differ(open_config):
+    """Different engines should not produce the same values."""
+    philox = open_config(engine_json("philox4x64"), "/vsimem/philox.json").GetRasterBand(1).ReadAsArray()
+    threefry = open_config(engine_json("threefry4x64"), "/vsimem/threefry.json").GetRasterBand(1).ReadAsArray()
+    assert not np.array_equal(philox, threefry)
+
+def test_unknown_engine(open_config):
+    """Verify that an unknown engine is reported as an error."""
+    config = engine_json("minstd")
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/unknown_engine.json")
+    assert ds is None, "Dataset should not be created with an unknown engine."
+    assert "not a supported random engine" in gdal.GetLastErrorMsg()
@@ -0,0 +1,37 @@
+import numpy as np
+import pytest
+
+def read_config(open_config, distribution, parameters, seed=5):
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 500,
+        "cols": 400,
+        "data_type": "Float64",
+        "seed": seed,
+        "distribution": distribution,
+        "distribution_parameters": parameters
+    }
+    ds = open_config(config, "/vsimem/gamma_family.json")
+    assert ds is not None, f"GDAL could not open the {distribution} dataset."
+    return ds.GetRasterBand(1).ReadAsArray()
+
+@pytest.mark.parametrize("distribution, parameters, mean, variance", [
+    ("gamma", {"alpha": 0.5, "beta": 2.0}, 1.0, 2.0),
+    ("gamma", {"alpha": 3.0, "beta": 1.5}, 4.5, 6.75),
+    ("chi_squared", {"n": 3.0}, 3.0, 6.0),
+    ("student_t", {"n": 6.0}, 0.0, 1.5),
+    ("fisher_f", {"m": 5.0, "n": 10.0}, 1.25, 1.3541667),
+])
+def test_gamma_family_moments(open_config, distribution, parameters, mean, variance):
+    """Verify the mean and variance of the gamma family of distributions."""
+    data = read_config(open_config, distribution, parameters)
+    assert np.all(np.isfinite(data))
+    assert abs(data.mean() - mean) < 0.02 * max(1.0, abs(mean))
+    assert abs(data.var() - variance) < 0.05 * variance
+
+def test_gamma_reproducible(open_config):
+    """Rejection sampling must still give reproducible results."""
+    a = read_config(open_config, "gamma", {"alpha": 0.3})
+    b = read_config(open_config, "gamma", {"alpha": 0.3})
+    assert np.array_equal(a, b)
+    assert np.all(a >= 0)
@@ -0,0 +1,73 @@
+import numpy as np
+import pytest
+
+def field_config(covariance, block_size=64, data_type="Float64", **extra):
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 512,
+        "cols": 512,
+        "block_rows": block_size,
+        "block_cols": block_size,
+        "data_type": data_type,
+        "seed": 42,
+        "distribution": "gaussian_random_field",
+        "distribution_parameters": {
+            "mean": 10.0, "stddev": 2.0, "covariance": covariance, "correlation_length": 5.0
+        }
+    }
+    config.update(extra)
+    return config
+
+def lag_one_correlation(data):
+    centered = data - data.mean()
+    return np.mean(centered[:, :-1] * centered[:, 1:]) / centered.var()
+
+@pytest.mark.parametrize("covariance, expected", [
+    ("exponential", np.exp(-1.0 / 5.0)),
+    ("gaussian", np.exp(-1.0 / 25.0)),
+    ("matern", (1.0 + np.sqrt(3.0) / 5.0) * np.exp(-np.sqrt(3.0) / 5.0))])
+def test_field_moments_and_correlation(open_config, covariance, expected):
+    """Verify the marginal moments and the correlation of neighbouring cells."""
+    ds = open_config(field_config(covariance), "/vsimem/grf_moments.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray()
+
+    assert abs(data.mean() - 10.0) < 0.1
+    assert abs(data.std() - 2.0) < 0.05
+    assert abs(lag_one_correlation(data) - expected) < 0.02
+
+def test_field_does_not_depend_on_block_size(open_config):
+    """The same field is generated whatever the block size."""
+    small = open_config(field_config("exponential", 64), "/vsimem/grf_small.json")
+    large = open_config(field_config("exponential", 100), "/vsimem/grf_large.json")
+    assert small is not None and large is not None
+    a = small.GetRasterBand(1).ReadAsArray()
+    b = large.GetRasterBand(1).ReadAsArray()
+    assert np.allclose(a, b, atol=1e-9)
+
+    # Windows are cut from whole blocks.
+    window = small.GetRasterBand(1).ReadAsArray(50, 70, 30, 20)
+    assert np.array_equal(window, a[70:90, 50:80])
+
+def test_bands_are_independent(open_config):
+    config = field_config("gaussian", bands=[{}, {}])
+    ds = open_config(config, "/vsimem/grf_bands.json")
+    assert ds is not None
+    a = ds.GetRasterBand(1).ReadAsArray().ravel()
+    b = ds.GetRasterBand(2).ReadAsArray().ravel()
+    assert abs(np.corrcoef(a, b)[0, 1]) < 0.1
+
+def test_correlation_length_within_block_size(open_config):
+    config = field_config("exponential", 16)
+    config["distribution_parameters"]["correlation_length"] = 20.0
+    assert open_config(config, "/vsimem/grf_long.json") is None
+    config["distribution_parameters"]["correlation_length"] = 16.0
+    assert open_config(config, "/vsimem/grf_long.json") is not None
+
+@pytest.mark.parametrize("data_type, extra", [
+    ("Int32", {}),
+    ("Float32", {"sampling": "inverse_cdf_table"}),
+    ("Float32", {"aggregate": {"factor": 2}})])
+def test_invalid_configurations(open_config, data_type, extra):
+    ds = open_config(field_config("exponential", data_type=data_type, **extra), "/vsimem/grf_invalid.json")
+    assert ds is None
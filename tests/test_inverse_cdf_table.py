@@ -0,0 +1,101 @@
+import math
+import numpy as np
+import pytest
+from osgeo import gdal
+
+def table_json(distribution, parameters, data_type="Float64"):
+    """Provides a configuration that samples from the inverse CDF table."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 500,
+        "cols": 400,
+        "data_type": data_type,
+        "seed": 99,
+        "block_rows": 64,
+        "block_cols": 64,
+        "sampling": "inverse_cdf_table",
+        "distribution": distribution,
+        "distribution_parameters": parameters
+    }
+
+@pytest.mark.parametrize("distribution,parameters,mean,std", [
+    ("uniform_real", {"a": 2.0, "b": 5.0}, 3.5, 3.0 / np.sqrt(12.0)),
+    ("normal", {"mean": 1.0, "stddev": 2.0}, 1.0, 2.0),
+    ("exponential", {"lambda": 2.0}, 0.5, 0.5),
+    ("weibull", {"a": 2.0, "b": 1.0}, 0.886227, 0.463251),
+    ("extreme_value", {"a": 0.0, "b": 1.0}, 0.577216, np.pi / np.sqrt(6.0)),
+    ("gamma", {"alpha": 3.0, "beta": 2.0}, 6.0, np.sqrt(12.0)),
+    ("chi_squared", {"n": 4.0}, 4.0, np.sqrt(8.0)),
+    ("student_t", {"n": 5.0}, 0.0, np.sqrt(5.0 / 3.0))])
+def test_table_moments(open_config, distribution, parameters, mean, std):
+    """The tabulated distributions should have the expected mean and standard deviation."""
+    ds = open_config(table_json(distribution, parameters), "/vsimem/table.json")
+    assert ds is not None, "GDAL could not open the dataset from the virtual file."
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert abs(data.mean() - mean) < 0.02 * max(1.0, std)
+    assert abs(data.std() - std) < 0.02 * max(1.0, std)
+
+@pytest.mark.parametrize("distribution,parameters,near,far", [
+    ("normal", {"mean": 0.0, "stddev": 1.0}, 4.0, 5.0),
+    ("cauchy", {"a": 0.0, "b": 1.0}, 1e4, 1e6)])
+def test_table_tails(open_config, distribution, parameters, near, far):
+    """The tails beyond the table have the frequencies of the distribution."""
+    config = table_json(distribution, parameters)
+    config.update({"rows": 2000, "cols": 2000, "block_rows": 256, "block_cols": 256})
+    data = np.abs(open_config(config, "/vsimem/table_tails.json").GetRasterBand(1).ReadAsArray())
+    if distribution == "normal":
+        p_near, p_far = math.erfc(near / math.sqrt(2.0)), math.erfc(far / math.sqrt(2.0))
+    else:
+        p_near, p_far = 1.0 - 2.0 * math.atan(near) / math.pi, 1.0 - 2.0 * math.atan(far) / math.pi
+    expected_near = p_near * data.size
+    expected_far = p_far * data.size
+    assert abs(np.count_nonzero(data > near) - expected_near) < 5.0 * math.sqrt(expected_near)
+    assert np.count_nonzero(data > far) < expected_far + 5.0 * math.sqrt(expected_far) + 5
+
+def test_table_truncation(open_config):
+    """Truncated values stay within the bounds and follow the truncated distribution."""
+    config = table_json("cauchy", {"a": 0.0, "b": 1.0}, "Float32")
+    config["truncation"] = {"min": -1.0, "max": 1.0}
+    data = open_config(config, "/vsimem/table_truncated.json").GetRasterBand(1).ReadAsArray()
+    assert data.min() >= -1.0
+    assert data.max() <= 1.0
+    # Within [-1, 1] half of the mass of the truncated Cauchy lies in [-tan(pi/8), tan(pi/8)]
+    inner = np.mean(np.abs(data) < np.tan(np.pi / 8))
+    assert abs(inner - 0.5) < 0.01
+
+def test_table_is_reproducible(open_config):
+    """Tabulated sampling depends only on the seed."""
+    config = table_json("lognormal", {"m": 0.0, "s": 0.5})
+    first = open_config(config, "/vsimem/table_a.json").GetRasterBand(1).ReadAsArray()
+    second = open_config(config, "/vsimem/table_b.json").GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(first, second)
+
+def test_table_rejects_integer_distribution(open_config):
+    """Tabulated sampling is not supported for integer distributions."""
+    config = table_json("poisson", {"mean": 4.0}, "Int32")
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/table_poisson.json")
+    assert ds is None
+    assert "only supported for continuous distributions" in gdal.GetLastErrorMsg()
+
+def test_truncation_requires_table(open_config):
+    """Truncation is reported as an error without tabulated sampling."""
+    config = table_json("normal", {})
+    del config["sampling"]
+    config["truncation"] = {"min": 0.0}
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/table_direct.json")
+    assert ds is None
+    assert "requires" in gdal.GetLastErrorMsg()
+
+def test_truncation_without_mass(open_config):
+    """A truncation interval outside the support is reported as an error."""
+    config = table_json("exponential", {"lambda": 1.0})
+    config["truncation"] = {"max": -1.0}
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/table_empty.json")
+    assert ds is None
+    assert "zero probability" in gdal.GetLastErrorMsg()
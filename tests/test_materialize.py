@@ -0,0 +1,87 @@
+import json
+import os
+import subprocess
+import numpy as np
+import pytest
+from osgeo import gdal
+
+MATERIALIZE = os.environ.get("RANDOM_RASTER_MATERIALIZE")
+
+pytestmark = pytest.mark.skipif(not MATERIALIZE, reason="RANDOM_RASTER_MATERIALIZE is not set")
+
+def write_config(config, tmp_path):
+    path = tmp_path / "config.json"
+    with open(path, "w") as f:
+        json.dump(config, f)
+    return str(path)
+
+def materialize(*args):
+    return subprocess.run([MATERIALIZE, "-q", *[str(arg) for arg in args]], capture_output=True, text=True)
+
+def normal_config(**extra):
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 700,
+        "cols": 1100,
+        "block_rows": 100,
+        "block_cols": 100,
+        "data_type": "Float32",
+        "seed": 21,
+        "distribution": "normal",
+        "distribution_parameters": {"mean": 10.0, "stddev": 2.0}
+    }
+    config.update(extra)
+    return config
+
+def test_gtiff_has_the_values_of_the_dataset(tmp_path):
+    config = write_config(normal_config(), tmp_path)
+    output = tmp_path / "out.tif"
+    # A small memory budget gives several windows per row of tiles.
+    result = materialize("-threads", 4, "-tile_size", 256, "-max_memory", 1, config, output)
+    assert result.returncode == 0, result.stderr
+    ds = gdal.Open(str(output))
+    assert ds.GetDriver().ShortName == "GTiff"
+    assert ds.GetRasterBand(1).GetBlockSize() == [256, 256]
+    assert ds.GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE") == "DEFLATE"
+    expected = gdal.Open(config).GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(ds.GetRasterBand(1).ReadAsArray(), expected)
+
+def test_bands_and_nodata(tmp_path):
+    config = normal_config(data_type="Int16", bands=[{}, {"distribution": "uniform_integer",
+        "distribution_parameters": {"a": 0, "b": 9}}], nodata={"value": -1, "probability": 0.1})
+    config["distribution"] = "poisson"
+    config["distribution_parameters"] = {"mean": 4.0}
+    path = write_config(config, tmp_path)
+    output = tmp_path / "bands.tif"
+    result = materialize("-co", "COMPRESS=LZW", path, output)
+    assert result.returncode == 0, result.stderr
+    ds = gdal.Open(str(output))
+    source = gdal.Open(path)
+    assert ds.RasterCount == 2
+    assert ds.GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE") == "LZW"
+    for i in (1, 2):
+        assert ds.GetRasterBand(i).GetNoDataValue() == -1
+        assert np.array_equal(ds.GetRasterBand(i).ReadAsArray(), source.GetRasterBand(i).ReadAsArray())
+
+def test_cog(tmp_path):
+    config = write_config(normal_config(addressing="pixel"), tmp_path)
+    output = tmp_path / "out_cog.tif"
+    result = materialize("-of", "COG", config, output)
+    assert result.returncode == 0, result.stderr
+    ds = gdal.Open(str(output))
+    assert ds.GetMetadataItem("LAYOUT", "IMAGE_STRUCTURE") == "COG"
+    expected = gdal.Open(config).GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(ds.GetRasterBand(1).ReadAsArray(), expected)
+
+@pytest.mark.parametrize("args", [["-of", "PNG"], ["-tile_size", "100"], ["-unknown"]])
+def test_invalid_arguments(tmp_path, args):
+    config = write_config(normal_config(), tmp_path)
+    assert materialize(*args, config, tmp_path / "invalid.tif").returncode != 0
+
+def test_missing_output(tmp_path):
+    assert materialize(write_config(normal_config(), tmp_path)).returncode != 0
+
+def test_not_a_random_raster(tmp_path):
+    path = tmp_path / "other.json"
+    path.write_text('{"type": "FeatureCollection", "features": []}')
+    assert materialize(path, tmp_path / "other.tif").returncode != 0
@@ -0,0 +1,100 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+@pytest.fixture
+def nodata_json(base_config):
+    """Provides configurations with missing cells, in a raster that its
+    blocks do not divide, so that partial blocks are masked as well."""
+    def nodata_json(pattern="pixel", probability=0.2, data_type="Int16"):
+        return base_config("uniform_integer", {"a": 0, "b": 100}, data_type, rows=200, cols=150,
+                           block_rows=32, block_cols=40, seed=31,
+                           nodata={"value": -1, "probability": probability, "pattern": pattern})
+    return nodata_json
+
+@pytest.mark.parametrize("pattern", ["pixel", "block"])
+def test_nodata_values_and_mask(open_config, nodata_json, pattern):
+    """Missing cells hold the nodata value, the mask band marks them, and the other values are unchanged."""
+    config = nodata_json(pattern)
+    band = open_config(config, "/vsimem/nodata.json").GetRasterBand(1)
+    assert band.GetNoDataValue() == -1
+    assert band.GetMaskFlags() == gdal.GMF_PER_DATASET
+
+    data = band.ReadAsArray()
+    mask = band.GetMaskBand().ReadAsArray()
+    missing = data == -1
+    assert np.array_equal(mask, np.where(missing, 0, 255))
+    if pattern == "pixel":
+        assert abs(missing.mean() - 0.2) < 0.02
+    else:
+        assert 0.0 < missing.mean() < 0.5
+
+    del config["nodata"]
+    complete = open_config(config, "/vsimem/complete.json").GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(data[~missing], complete[~missing])
+
+def test_nodata_block_pattern(open_config, nodata_json):
+    """With the block pattern whole blocks are missing, and reported as empty."""
+    band = open_config(nodata_json("block", 0.5), "/vsimem/nodata.json").GetRasterBand(1)
+    data = band.ReadAsArray()
+    found = set()
+    for i in range(0, 200, 32):
+        for j in range(0, 150, 40):
+            block = data[i:i + 32, j:j + 40]
+            missing = bool((block == -1).all())
+            assert missing or not (block == -1).any()
+            flags, percentage = band.GetDataCoverageStatus(j, i, block.shape[1], block.shape[0])
+            expected = gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY if missing else gdal.GDAL_DATA_COVERAGE_STATUS_DATA
+            assert flags == expected
+            assert percentage == (0.0 if missing else 100.0)
+            found.add(missing)
+    assert found == {True, False}
+
+def test_nodata_shared_by_bands(open_config, nodata_json):
+    """All bands have the same missing cells and the same mask band."""
+    config = nodata_json(data_type="Float32")
+    config["bands"] = [{}, {"distribution": "normal", "distribution_parameters": {"mean": 0.0, "stddev": 1.0}}]
+    ds = open_config(config, "/vsimem/nodata.json")
+    first = ds.GetRasterBand(1).ReadAsArray() == -1
+    second = ds.GetRasterBand(2).ReadAsArray() == -1
+    assert first.any()
+    assert np.array_equal(first, second)
+    assert np.array_equal(ds.GetRasterBand(1).GetMaskBand().ReadAsArray(),
+                          ds.GetRasterBand(2).GetMaskBand().ReadAsArray())
+
+def test_nodata_statistics(open_config, nodata_json):
+    """The statistics only describe the valid cells."""
+    band = open_config(nodata_json(), "/vsimem/nodata.json").GetRasterBand(1)
+    minimum, maximum, mean, stddev = band.ComputeStatistics(False)
+    data = band.ReadAsArray()
+    valid = data[data != -1].astype(np.float64)
+    assert (minimum, maximum) == (valid.min(), valid.max())
+    assert mean == pytest.approx(valid.mean())
+    assert float(band.GetMetadataItem("STATISTICS_VALID_PERCENT")) == pytest.approx(100.0 * valid.size / data.size, abs=0.01)
+    assert sum(band.GetHistogram(-0.5, 100.5, 101, approx_ok=1)) == pytest.approx(valid.size, rel=0.01)
+
+def test_nodata_value_must_fit(open_config, nodata_json):
+    """The nodata value must be representable in the data type."""
+    with gdal.quiet_errors():
+        ds = open_config(nodata_json(data_type="Byte"), "/vsimem/nodata.json")
+    assert ds is None
+
+@pytest.mark.parametrize("data_type,distribution,parameters,value", [
+    ("Byte", "uniform_integer", {"a": 0, "b": 255}, 0),
+    ("Int16", "uniform_integer", {"a": 0, "b": 100}, 50),
+    ("Int32", "poisson", {"mean": 4.0}, 0),
+    ("Int16", "discrete", {"weights": [1.0, 1.0]}, 1),
+])
+def test_nodata_value_outside_distribution(open_config, nodata_json, data_type, distribution, parameters, value):
+    """The nodata value must not be a value that the distribution generates."""
+    config = nodata_json(data_type=data_type)
+    config.update({"distribution": distribution, "distribution_parameters": parameters})
+    config["nodata"]["value"] = value
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/nodata.json")
+    assert ds is None
+
+    # Values of the distribution with no probability do not collide.
+    config.update({"distribution": "discrete", "distribution_parameters": {"weights": [1.0, 0.0, 1.0]}})
+    config["nodata"]["value"] = 1
+    assert open_config(config, "/vsimem/nodata.json") is not None
@@ -0,0 +1,45 @@
+import numpy as np
+import pytest
+
+@pytest.mark.parametrize("data_type", ["Float32", "Float64"])
+def test_normal_moments(open_config, data_type):
+    """Verify mean, standard deviation and tail mass of the normal distribution."""
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 500,
+        "cols": 400,
+        "data_type": data_type,
+        "seed": 77,
+        "distribution": "normal",
+        "distribution_parameters": {"mean": 10.0, "stddev": 2.0}
+    }
+    ds = open_config(config, "/vsimem/normal.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray().astype(np.float64)
+
+    assert abs(data.mean() - 10.0) < 0.03
+    assert abs(data.std() - 2.0) < 0.03
+    # P(|Z| > 2) = 0.0455
+    assert abs(np.mean(np.abs(data - 10.0) > 4.0) - 0.0455) < 0.003
+    # Values beyond the base layer of the ziggurat (|Z| > 3.654) must occur
+    assert np.any(np.abs(data - 10.0) > 2.0 * 3.7)
+
+def test_lognormal_moments(open_config):
+    """Verify that the log of a lognormal raster is normally distributed."""
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 500,
+        "cols": 400,
+        "data_type": "Float64",
+        "seed": 78,
+        "distribution": "lognormal",
+        "distribution_parameters": {"m": 1.0, "s": 0.5}
+    }
+    ds = open_config(config, "/vsimem/lognormal.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray()
+
+    assert np.all(data > 0)
+    log_data = np.log(data)
+    assert abs(log_data.mean() - 1.0) < 0.01
+    assert abs(log_data.std() - 0.5) < 0.01
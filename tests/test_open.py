@@ -0,0 +1,95 @@
+import json
+import numpy as np
+from osgeo import gdal
+
+def write_config(config, vsi_filename, text=None):
+    text = json.dumps(config) if text is None else text
+    gdal.FileFromMemBuffer(vsi_filename, text.encode('utf-8'))
+
+def dice_config(seed=7):
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 60,
+        "cols": 80,
+        "data_type": "Int32",
+        "distribution": "uniform_integer",
+        "distribution_parameters": {"a": 1, "b": 6}
+    }
+    if seed is not None:
+        config["seed"] = seed
+    return config
+
+def read(vsi_filename):
+    ds = gdal.Open(vsi_filename)
+    assert ds is not None
+    return ds.GetRasterBand(1).ReadAsArray()
+
+def test_configuration_larger_than_the_header():
+    """The whole file is parsed, not only the header that GDAL reads."""
+    config = dice_config()
+    config["distribution"] = "discrete"
+    config["distribution_parameters"] = {"weights": [1.0] * 999 + [1000.0]}
+    filename = "/vsimem/large.json"
+    write_config(config, filename)
+    assert len(json.dumps(config)) > 4096
+    data = read(filename)
+    assert np.mean(data == 999) > 0.4
+    gdal.Unlink(filename)
+
+def test_type_beyond_the_header():
+    config = {"distribution_parameters": {"weights": [1.0] * 1000}}
+    config.update({k: v for k, v in dice_config().items() if k != "distribution_parameters"})
+    config["distribution"] = "discrete"
+    text = json.dumps(config)
+    assert text.index("RANDOM_RASTER") > 4096
+    filename = "/vsimem/type_last.json"
+    write_config(None, filename, text)
+    assert read(filename).max() <= 999
+    gdal.Unlink(filename)
+
+def test_other_json_is_not_identified():
+    filename = "/vsimem/other.json"
+    for text in ['{"type": "FeatureCollection", "name": "RANDOM_RASTER", "features": []}',
+                 '["type", "RANDOM_RASTER"]', 'not json at all "type": "RANDOM_RASTER"']:
+        write_config(None, filename, text)
+        driver = gdal.IdentifyDriver(filename)
+        assert driver is None or driver.ShortName != "RANDOM_RASTER"
+    gdal.Unlink(filename)
+
+def test_reopen_gives_the_same_values():
+    filename = "/vsimem/reopen.json"
+    write_config(dice_config(), filename)
+    first = read(filename)
+    a = gdal.Open(filename)
+    b = gdal.Open(filename)
+    assert np.array_equal(a.GetRasterBand(1).ReadAsArray(), first)
+    assert np.array_equal(b.GetRasterBand(1).ReadAsArray(), first)
+    gdal.Unlink(filename)
+
+def test_changed_file_is_opened_anew():
+    """A file that is rewritten, also with the same size and within a second, is parsed again."""
+    filename = "/vsimem/changed.json"
+    write_config(dice_config(seed=11), filename)
+    first = read(filename)
+    write_config(dice_config(seed=12), filename)
+    second = read(filename)
+    assert not np.array_equal(first, second)
+    gdal.Unlink(filename)
+
+def test_configuration_without_seed_is_not_reused():
+    filename = "/vsimem/no_seed.json"
+    write_config(dice_config(seed=None), filename)
+    assert not np.array_equal(read(filename), read(filename))
+    gdal.Unlink(filename)
+
+def test_cache_disabled():
+    filename = "/vsimem/no_cache.json"
+    write_config(dice_config(), filename)
+    cached = read(filename)
+    gdal.SetConfigOption("RANDOM_RASTER_CONFIG_CACHE", "0")
+    try:
+        assert np.array_equal(read(filename), cached)
+        assert np.array_equal(read(filename), cached)
+    finally:
+        gdal.SetConfigOption("RANDOM_RASTER_CONFIG_CACHE", None)
+    gdal.Unlink(filename)
@@ -0,0 +1,60 @@
+import numpy as np
+import pytest
+
+def overview_json(addressing, rows=300, cols=200):
+    """Provides a configuration with blocks that do not divide the raster."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": rows,
+        "cols": cols,
+        "data_type": "Int32",
+        "seed": 5,
+        "block_rows": 32,
+        "block_cols": 24,
+        "engine": "philox4x64",
+        "addressing": addressing,
+        "distribution": "uniform_integer",
+        "distribution_parameters": {"a": 0, "b": 1000000}
+    }
+
+def test_overview_levels(open_config):
+    """Levels halve the size until the overview fits in a block."""
+    band = open_config(overview_json("pixel"), "/vsimem/levels.json").GetRasterBand(1)
+    sizes = [(band.GetOverview(i).YSize, band.GetOverview(i).XSize) for i in range(band.GetOverviewCount())]
+    assert sizes == [(150, 100), (75, 50), (38, 25), (19, 13)]
+    assert band.GetOverview(band.GetOverviewCount()) is None
+
+def test_overviews_decimate_base_band(open_config, nearest):
+    """Overview pixels are the nearest pixels of the base band."""
+    band = open_config(overview_json("pixel"), "/vsimem/decimate.json").GetRasterBand(1)
+    full = band.ReadAsArray()
+    for i in range(band.GetOverviewCount()):
+        overview = band.GetOverview(i)
+        expected = full[np.ix_(nearest(300, overview.YSize), nearest(200, overview.XSize))]
+        assert np.array_equal(overview.ReadAsArray(), expected)
+        assert np.array_equal(overview.ReadAsArray(3, 2, 7, 5), expected[2:7, 3:10])
+        block = np.frombuffer(overview.ReadBlock(0, 0), dtype=np.int32)
+        block_cols, block_rows = overview.GetBlockSize()
+        assert np.array_equal(block.reshape(block_rows, block_cols)[:min(block_rows, overview.YSize), :min(block_cols, overview.XSize)],
+                              expected[:block_rows, :block_cols])
+
+def test_downsampled_read(open_config):
+    """A downsampled read of the base band equals the overview."""
+    band = open_config(overview_json("pixel"), "/vsimem/downsampled.json").GetRasterBand(1)
+    preview = band.ReadAsArray(buf_xsize=50, buf_ysize=75)
+    assert np.array_equal(preview, band.GetOverview(1).ReadAsArray())
+
+def test_large_preview(open_config):
+    """A preview of a very large raster only generates the preview pixels."""
+    band = open_config(overview_json("pixel", 100000, 100000), "/vsimem/large.json").GetRasterBand(1)
+    preview = band.ReadAsArray(buf_xsize=98, buf_ysize=98)
+    assert preview.shape == (98, 98)
+    overviews = [band.GetOverview(i) for i in range(band.GetOverviewCount())]
+    matching = [overview for overview in overviews if overview.XSize == 98]
+    assert len(matching) == 1
+    assert np.array_equal(preview, matching[0].ReadAsArray())
+
+def test_no_overviews_with_block_addressing(open_config):
+    """Block addressing cannot decimate cheaply and has no overviews."""
+    band = open_config(overview_json("block"), "/vsimem/block.json").GetRasterBand(1)
+    assert band.GetOverviewCount() == 0
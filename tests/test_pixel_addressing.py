@@ -0,0 +1,86 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+PIXEL_ENGINES = ["philox4x64", "threefry4x64", "xoshiro256++", "pcg64"]
+
+def pixel_json(block_rows, block_cols, engine=None, distribution="normal"):
+    """Provides a pixel addressed configuration with the given block size."""
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 100,
+        "cols": 70,
+        "data_type": "Float64",
+        "seed": 1234,
+        "block_rows": block_rows,
+        "block_cols": block_cols,
+        "addressing": "pixel",
+        "distribution": distribution,
+        "distribution_parameters": {}
+    }
+    if engine is not None:
+        config["engine"] = engine
+    return config
+
+@pytest.mark.parametrize("engine", PIXEL_ENGINES)
+def test_pixel_addressing_is_block_size_invariant(open_config, engine):
+    """Values should not depend on the block size with pixel addressing."""
+    square = open_config(pixel_json(32, 32, engine), "/vsimem/square.json").GetRasterBand(1).ReadAsArray()
+    strip = open_config(pixel_json(1, 70, engine), "/vsimem/strip.json").GetRasterBand(1).ReadAsArray()
+    odd = open_config(pixel_json(17, 23, engine), "/vsimem/odd.json").GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(square, strip)
+    assert np.array_equal(square, odd)
+    assert abs(np.mean(square)) < 0.1
+    assert abs(np.std(square) - 1.0) < 0.1
+
+def test_pixel_addressing_window(open_config):
+    """A window read on its own should equal the same window of the full raster."""
+    full = open_config(pixel_json(32, 32), "/vsimem/full.json").GetRasterBand(1).ReadAsArray()
+    window = open_config(pixel_json(7, 9), "/vsimem/window.json").GetRasterBand(1).ReadAsArray(13, 41, 20, 30)
+    assert np.array_equal(window, full[41:71, 13:33])
+
+@pytest.mark.parametrize("distribution,parameters,data_type", [
+    ("uniform_integer", {"a": 0, "b": 199}, "Byte"),
+    ("uniform_real", {"a": 0.0, "b": 1.0}, "Float32"),
+    ("discrete", {"weights": [1.0, 2.0, 3.0]}, "Byte"),
+    ("poisson", {"mean": 3.0}, "Int16"),
+    ("gamma", {"alpha": 0.5, "beta": 1.0}, "Float64")])
+def test_pixel_addressing_long_rows(open_config, distribution, parameters, data_type):
+    """Rows longer than a chunk of the samplers should not depend on the block size."""
+    config = pixel_json(8, 1500, "philox4x64", distribution)
+    config.update({"rows": 8, "cols": 1500, "data_type": data_type, "distribution_parameters": parameters})
+    strip = open_config(config, "/vsimem/long.json").GetRasterBand(1).ReadAsArray()
+    config.update({"block_rows": 3, "block_cols": 1})
+    column = open_config(config, "/vsimem/column.json").GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(strip, column)
+
+def test_pixel_addressing_rejects_mt19937_64(open_config):
+    """mt19937_64 cannot be keyed per pixel, this should be reported as an error."""
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(pixel_json(32, 32, "mt19937_64"), "/vsimem/mt_pixel.json")
+    assert ds is None
+    assert "Pixel addressing is not supported" in gdal.GetLastErrorMsg()
+
+def test_unknown_addressing(open_config):
+    """Verify that an unknown addressing mode is reported as an error."""
+    config = pixel_json(32, 32)
+    config["addressing"] = "tile"
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/unknown_addressing.json")
+    assert ds is None
+    assert "not a supported addressing mode" in gdal.GetLastErrorMsg()
+
+@pytest.mark.parametrize("addressing", ["block", "pixel"])
+def test_edge_blocks_are_reproducible(open_config, addressing):
+    """Edge blocks only hold valid values and are identical when read again."""
+    config = pixel_json(32, 32, "philox4x64", "uniform_real")
+    config["addressing"] = addressing
+    config["distribution_parameters"] = {"a": 1.0, "b": 2.0}
+    ds = open_config(config, "/vsimem/edge.json")
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert np.all(data >= 1.0)
+    assert np.all(data < 2.0)
+    edge = open_config(config, "/vsimem/edge2.json").GetRasterBand(1).ReadAsArray(64, 96, 6, 4)
+    assert np.array_equal(edge, data[96:100, 64:70])
@@ -0,0 +1,67 @@
+import numpy as np
+import pytest
+
+@pytest.fixture
+def prefetch_json(base_config):
+    """Provides configurations of 13 x 5 small blocks, so that a reader
+    that goes block by block lets the prefetcher run ahead of it."""
+    def prefetch_json(addressing="block"):
+        return base_config("normal", {"mean": 0.0, "stddev": 1.0}, "Float32", rows=200, cols=150,
+                           block_rows=16, block_cols=32, seed=7, addressing=addressing)
+    return prefetch_json
+
+def blocks_in_order(band, order):
+    return [band.ReadBlock(j, i) for i, j in order]
+
+def row_major(band):
+    block_cols, block_rows = band.GetBlockSize()
+    rows = (band.YSize + block_rows - 1) // block_rows
+    cols = (band.XSize + block_cols - 1) // block_cols
+    return [(i, j) for i in range(rows) for j in range(cols)]
+
+@pytest.mark.parametrize("addressing", ["block", "pixel"])
+@pytest.mark.parametrize("depth", ["1", "4", "32"])
+def test_prefetch_is_bit_identical(open_config, prefetch_json, addressing, depth):
+    """Prefetched blocks should equal the blocks generated on demand."""
+    config = prefetch_json(addressing)
+    plain = open_config(config, "/vsimem/plain.json").GetRasterBand(1)
+    ds = open_config(config, "/vsimem/prefetch.json", ["PREFETCH_DEPTH=" + depth, "NUM_THREADS=2"])
+    band = ds.GetRasterBand(1)
+    order = row_major(band)
+    assert blocks_in_order(band, order) == blocks_in_order(plain, order)
+
+    # Random access should still give the correct blocks.
+    rng = np.random.default_rng(1)
+    shuffled = [order[k] for k in rng.permutation(len(order))]
+    assert blocks_in_order(band, shuffled) == blocks_in_order(plain, shuffled)
+
+def test_prefetch_hit_rate(open_config, prefetch_json):
+    """Sequential reads should mostly be served from the prefetched blocks."""
+    ds = open_config(prefetch_json(), "/vsimem/hits.json", ["PREFETCH_DEPTH=8"])
+    band = ds.GetRasterBand(1)
+    order = row_major(band)
+    blocks_in_order(band, order)
+    hits = int(band.GetMetadataItem("HITS", "PREFETCH"))
+    misses = int(band.GetMetadataItem("MISSES", "PREFETCH"))
+    assert hits + misses == len(order)
+    assert hits >= len(order) - 2
+    assert float(band.GetMetadataItem("HIT_RATE", "PREFETCH")) > 0.9
+
+def test_prefetch_disabled_by_default(open_config, prefetch_json):
+    """Without PREFETCH_DEPTH nothing is prefetched."""
+    band = open_config(prefetch_json(), "/vsimem/off.json").GetRasterBand(1)
+    blocks_in_order(band, row_major(band))
+    assert band.GetMetadataItem("HITS", "PREFETCH") == "0"
+
+def test_prefetch_bands_share_threads(open_config, prefetch_json):
+    """Bands read in turn share the background threads and each get their own blocks."""
+    config = prefetch_json()
+    config["bands"] = [{}, {"distribution": "uniform_real", "distribution_parameters": {"a": 0.0, "b": 1.0}}, {}]
+    plain = open_config(config, "/vsimem/plain_bands.json")
+    ds = open_config(config, "/vsimem/prefetch_bands.json", ["PREFETCH_DEPTH=4", "NUM_THREADS=2"])
+    order = row_major(ds.GetRasterBand(1))
+    for i, j in order:
+        for b in (1, 2, 3):
+            assert ds.GetRasterBand(b).ReadBlock(j, i) == plain.GetRasterBand(b).ReadBlock(j, i)
+    for b in (1, 2, 3):
+        assert float(ds.GetRasterBand(b).GetMetadataItem("HIT_RATE", "PREFETCH")) > 0.9
@@ -0,0 +1,62 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+@pytest.fixture
+def io_json(base_config):
+    """Provides configurations with blocks of odd sizes that do not divide
+    the raster, so that windows cut through partial blocks."""
+    def io_json(addressing, distribution, parameters, data_type):
+        return base_config(distribution, parameters, data_type, rows=100, cols=70,
+                           block_rows=17, block_cols=23, seed=4321, addressing=addressing)
+    return io_json
+
+CASES = [
+    ("uniform_integer", {"a": 1, "b": 6}, "Byte"),
+    ("uniform_real", {"a": 0.0, "b": 1.0}, "Float32"),
+    ("normal", {"mean": 0.0, "stddev": 1.0}, "Float64"),
+    ("poisson", {"mean": 4.0}, "Int32"),
+]
+
+@pytest.mark.parametrize("addressing", ["block", "pixel"])
+@pytest.mark.parametrize("distribution,parameters,data_type", CASES)
+def test_raster_io_matches_blocks(open_config, io_json, read_by_blocks, addressing, distribution, parameters, data_type):
+    """Full and partial window reads should equal the blocks."""
+    config = io_json(addressing, distribution, parameters, data_type)
+    band = open_config(config, "/vsimem/io.json").GetRasterBand(1)
+    blocks = read_by_blocks(band)
+    assert np.array_equal(band.ReadAsArray(), blocks)
+    assert np.array_equal(band.ReadAsArray(5, 11, 40, 60), blocks[11:71, 5:45])
+    assert np.array_equal(band.ReadAsArray(69, 99, 1, 1), blocks[99:100, 69:70])
+
+@pytest.mark.parametrize("addressing", ["block", "pixel"])
+def test_raster_io_buffer_type(open_config, io_json, addressing):
+    """Reads into another data type should convert the generated values."""
+    config = io_json(addressing, "uniform_real", {"a": 0.0, "b": 100.0}, "Float32")
+    band = open_config(config, "/vsimem/io_type.json").GetRasterBand(1)
+    native = band.ReadAsArray()
+    as_double = band.ReadAsArray(buf_type=gdal.GDT_Float64)
+    assert as_double.dtype == np.float64
+    assert np.array_equal(as_double, native.astype(np.float64))
+    window = band.ReadAsArray(3, 20, 50, 30, buf_type=gdal.GDT_Float64)
+    assert np.array_equal(window, native[20:50, 3:53].astype(np.float64))
+
+def test_raster_io_pixel_interleaved(open_config, io_json):
+    """Dataset reads with pixel interleaving should equal the band reads."""
+    config = io_json("block", "normal", {"mean": 0.0, "stddev": 1.0}, "Float64")
+    ds = open_config(config, "/vsimem/io_interleaved.json")
+    expected = ds.GetRasterBand(1).ReadAsArray()
+    raw = ds.ReadRaster(0, 0, 70, 100, band_list=[1, 1],
+                        buf_pixel_space=16, buf_line_space=16 * 70, buf_band_space=8)
+    interleaved = np.frombuffer(raw, dtype=np.float64).reshape(100, 70, 2)
+    assert np.array_equal(interleaved[:, :, 0], expected)
+    assert np.array_equal(interleaved[:, :, 1], expected)
+
+def test_raster_io_resampled(open_config, io_json):
+    """Resampled reads go through the block cache and should still work."""
+    config = io_json("block", "uniform_integer", {"a": 1, "b": 6}, "Byte")
+    band = open_config(config, "/vsimem/io_resampled.json").GetRasterBand(1)
+    full = band.ReadAsArray()
+    half = band.ReadAsArray(0, 0, 70, 100, 35, 50)
+    assert half.shape == (50, 35)
+    assert np.array_equal(half, full[1::2, 1::2])
@@ -0,0 +1,66 @@
+import numpy as np
+import pytest
+
+def noise_config(block_size=64, **extra):
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 300,
+        "cols": 200,
+        "block_rows": block_size,
+        "block_cols": block_size,
+        "data_type": "Float64",
+        "seed": 11,
+        "addressing": "pixel",
+        "distribution": "normal",
+        "distribution_parameters": {"mean": 5.0, "stddev": 2.0}
+    }
+    config.update(extra)
+    return config
+
+def kernel_weights(kernel, radius):
+    d = np.arange(-radius, radius + 1, dtype=np.float64)
+    s = radius / 3.0
+    if kernel == "box":
+        w = np.ones_like(d)
+    elif kernel == "gaussian":
+        w = np.exp(-0.5 * (d / s) ** 2)
+    else:
+        w = np.exp(-np.abs(d) / s)
+    return w / w.sum()
+
+@pytest.mark.parametrize("kernel", ["box", "gaussian", "exponential"])
+def test_smoothing_of_the_white_noise(open_config, kernel):
+    """Away from the edges, the smoothed band is the convolution of the white noise of the band."""
+    radius = 4
+    noise = open_config(noise_config(), "/vsimem/white.json").GetRasterBand(1).ReadAsArray()
+    ds = open_config(noise_config(smoothed_noise={"kernel": kernel, "radius": radius}), "/vsimem/smoothed.json")
+    assert ds is not None
+    # The expected statistics, before any blocks are read.
+    w = kernel_weights(kernel, radius)
+    stddev = 2.0 * np.sum(w ** 2)
+    assert abs(ds.GetRasterBand(1).GetStatistics(0, 1)[3] - stddev) < 1e-9
+    smoothed = ds.GetRasterBand(1).ReadAsArray()
+
+    rows = np.apply_along_axis(lambda x: np.convolve(x, w, mode='valid'), 1, noise)
+    expected = np.apply_along_axis(lambda x: np.convolve(x, w, mode='valid'), 0, rows)
+    assert np.allclose(smoothed[radius:-radius, radius:-radius], expected, atol=1e-12)
+    assert abs(smoothed.std() - stddev) < 0.1 * stddev
+
+def test_smoothed_noise_does_not_depend_on_block_size(open_config):
+    smoothing = {"kernel": "gaussian", "radius": 6}
+    a = open_config(noise_config(64, smoothed_noise=smoothing), "/vsimem/a.json").GetRasterBand(1).ReadAsArray()
+    b = open_config(noise_config(50, smoothed_noise=smoothing), "/vsimem/b.json").GetRasterBand(1).ReadAsArray()
+    assert np.allclose(a, b, atol=1e-12)
+
+def test_smoothed_noise_of_integers(open_config):
+    config = noise_config(data_type="Byte", distribution="uniform_integer",
+                          distribution_parameters={"a": 0, "b": 200}, smoothed_noise={"kernel": "box", "radius": 2})
+    ds = open_config(config, "/vsimem/byte.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert abs(data.mean() - 100.0) < 2.0
+    assert data.std() < 0.3 * np.sqrt((201 ** 2 - 1) / 12.0)
+
+def test_smoothed_noise_requires_pixel_addressing(open_config):
+    config = noise_config(addressing="block", smoothed_noise={"radius": 2})
+    assert open_config(config, "/vsimem/block.json") is None
@@ -0,0 +1,90 @@
+import numpy as np
+import pytest
+
+def stats_json(distribution, parameters, data_type, extra=None):
+    config = {
+        "type": "RANDOM_RASTER",
+        "rows": 400,
+        "cols": 500,
+        "data_type": data_type,
+        "seed": 99,
+        "engine": "philox4x64",
+        "distribution": distribution,
+        "distribution_parameters": parameters
+    }
+    config.update(extra or {})
+    return config
+
+CASES = [
+    # distribution, parameters, data_type, mean, stddev
+    ("uniform_integer", {"a": 1, "b": 6}, "Byte", 3.5, np.sqrt(35.0 / 12.0)),
+    ("poisson", {"mean": 4.5}, "Int32", 4.5, np.sqrt(4.5)),
+    ("binomial", {"t": 20, "p": 0.3}, "UInt16", 6.0, np.sqrt(4.2)),
+    ("normal", {"mean": 10.0, "stddev": 2.0}, "Float32", 10.0, 2.0),
+    ("gamma", {"alpha": 2.0, "beta": 1.5}, "Float64", 3.0, 1.5 * np.sqrt(2.0)),
+    ("exponential", {"lambda": 2.0}, "Float64", 0.5, 0.5),
+]
+
+@pytest.mark.parametrize("distribution,parameters,data_type,mean,stddev", CASES)
+def test_statistics_analytic(open_config, distribution, parameters, data_type, mean, stddev):
+    """Statistics should be the exact moments, and agree with the data."""
+    band = open_config(stats_json(distribution, parameters, data_type), "/vsimem/stats.json").GetRasterBand(1)
+    minimum, maximum, band_mean, band_stddev = band.GetStatistics(False, True)
+    assert band_mean == pytest.approx(mean, rel=1e-6)
+    assert band_stddev == pytest.approx(stddev, rel=1e-6)
+
+    data = band.ReadAsArray().astype(np.float64)
+    assert abs(data.mean() - mean) < 0.02 * stddev
+    assert abs(data.std() - stddev) < 0.02 * stddev
+    # The extremes of the raster are expected near the reported ones
+    assert minimum <= data.min() + stddev
+    assert maximum >= data.max() - stddev
+
+def test_statistics_bounded(open_config):
+    """Bounded distributions should report the bounds of their support."""
+    band = open_config(stats_json("uniform_integer", {"a": 1, "b": 6}, "Byte"), "/vsimem/stats.json").GetRasterBand(1)
+    assert band.GetStatistics(False, True)[:2] == [1.0, 6.0]
+    assert band.GetMinimum() == 1.0
+    assert band.GetMaximum() == 6.0
+
+    extra = {"sampling": "inverse_cdf_table", "truncation": {"min": -1.0, "max": 2.0}}
+    band = open_config(stats_json("normal", {"mean": 0.0, "stddev": 1.0}, "Float64", extra),
+                       "/vsimem/stats.json").GetRasterBand(1)
+    minimum, maximum, mean, _ = band.GetStatistics(False, True)
+    assert (minimum, maximum) == (-1.0, 2.0)
+    assert abs(band.ReadAsArray().mean() - mean) < 0.01
+
+def test_statistics_undefined_moments(open_config):
+    """Without a mean, as for cauchy, the statistics should be computed from the data."""
+    band = open_config(stats_json("cauchy", {"a": 0.0, "b": 1.0}, "Float64"), "/vsimem/stats.json").GetRasterBand(1)
+    data = band.ReadAsArray()
+    minimum, maximum, mean, _ = band.GetStatistics(False, True)
+    assert minimum == data.min()
+    assert maximum == data.max()
+    assert mean == pytest.approx(data.mean())
+
+@pytest.mark.parametrize("distribution,parameters,data_type,mean,stddev", CASES)
+def test_histogram_expected(open_config, distribution, parameters, data_type, mean, stddev):
+    """Histograms should hold the expected counts, within sampling error of the data."""
+    band = open_config(stats_json(distribution, parameters, data_type), "/vsimem/stats.json").GetRasterBand(1)
+    low = mean - 2.0 * stddev
+    high = mean + 2.0 * stddev
+    expected = np.array(band.GetHistogram(low, high, 16, include_out_of_range=1, approx_ok=1))
+    assert expected.sum() == band.XSize * band.YSize
+
+    data = band.ReadAsArray().astype(np.float64).ravel()
+    index = np.clip(np.floor((data - low) / (high - low) * 16), 0, 15).astype(int)
+    observed = np.bincount(index, minlength=16)
+    assert np.all(np.abs(observed - expected) <= 5.0 * np.sqrt(expected) + 1)
+
+    # Exact histograms count the generated values.
+    exact = np.array(band.GetHistogram(low, high, 16, include_out_of_range=1, approx_ok=0))
+    assert np.abs(exact - observed).sum() <= 2
+
+def test_default_histogram(open_config):
+    """The default histogram of integer bands should have a bucket per value."""
+    band = open_config(stats_json("uniform_integer", {"a": 1, "b": 6}, "Byte"), "/vsimem/stats.json").GetRasterBand(1)
+    minimum, maximum, buckets, histogram = band.GetDefaultHistogram(force=0)
+    assert (minimum, maximum, buckets) == (0.5, 6.5, 6)
+    assert sum(histogram) == band.XSize * band.YSize
+    assert all(abs(count - band.XSize * band.YSize / 6.0) <= 1 for count in histogram)
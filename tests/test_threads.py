@@ -0,0 +1,49 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+@pytest.fixture
+def threads_json(base_config):
+    """Provides configurations of 10 x 6 blocks, the last row and column
+    partial, so that every thread gets several blocks of either size."""
+    def threads_json(addressing, distribution, parameters):
+        return base_config(distribution, parameters, "Float64", rows=300, cols=250,
+                           block_rows=32, block_cols=48, seed=99, addressing=addressing)
+    return threads_json
+
+CASES = [
+    ("block", "normal", {"mean": 0.0, "stddev": 1.0}),
+    ("block", "poisson", {"mean": 3.0}),
+    ("block", "uniform_integer", {"a": 0, "b": 999}),
+    ("pixel", "gamma", {"alpha": 0.5, "beta": 2.0}),
+]
+
+@pytest.mark.parametrize("num_threads", ["2", "7", "ALL_CPUS"])
+@pytest.mark.parametrize("addressing,distribution,parameters", CASES)
+def test_threads_are_bit_identical(open_config, threads_json, num_threads, addressing, distribution, parameters):
+    """The values should not depend on the number of threads."""
+    config = threads_json(addressing, distribution, parameters)
+    single = open_config(config, "/vsimem/single.json").GetRasterBand(1)
+    multi = open_config(config, "/vsimem/multi.json", ["NUM_THREADS=" + num_threads]).GetRasterBand(1)
+    assert np.array_equal(single.ReadAsArray(), multi.ReadAsArray())
+    assert np.array_equal(single.ReadAsArray(17, 29, 200, 250), multi.ReadAsArray(17, 29, 200, 250))
+    assert np.array_equal(single.ReadAsArray(buf_type=gdal.GDT_Float32),
+                          multi.ReadAsArray(buf_type=gdal.GDT_Float32))
+
+def test_gdal_num_threads(open_config, threads_json):
+    """GDAL_NUM_THREADS is used when the open option is not given."""
+    config = threads_json("block", "normal", {"mean": 0.0, "stddev": 1.0})
+    single = open_config(config, "/vsimem/single.json").GetRasterBand(1).ReadAsArray()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        multi = open_config(config, "/vsimem/config.json").GetRasterBand(1).ReadAsArray()
+    assert np.array_equal(single, multi)
+
+def test_invalid_num_threads(open_config, threads_json):
+    """An invalid number of threads is reported, and one thread is used."""
+    config = threads_json("block", "normal", {"mean": 0.0, "stddev": 1.0})
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        ds = open_config(config, "/vsimem/invalid.json", ["NUM_THREADS=none"])
+    assert ds is not None
+    assert "Invalid value for NUM_THREADS" in gdal.GetLastErrorMsg()
+    assert ds.GetRasterBand(1).ReadAsArray().shape == (300, 250)
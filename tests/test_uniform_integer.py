@@ -135,4 +135,46 @@ def test_uniform_integer_invalid_out_of_range(uniform_integer_json):
 
     assert ds is None, "Dataset should not be created with invalid type (string instead of int)."
     print(gdal.GetLastErrorMsg())
-    gdal.Unlink(vsi_filename)
\ No newline at end of file
+    gdal.Unlink(vsi_filename)
+
+def test_uniform_integer_unbiased_byte(open_config, uniform_integer_json):
+    """Verify that all values of a small Byte range are equally likely."""
+    config = uniform_integer_json.copy()
+    config["rows"] = 300
+    config["cols"] = 400
+    config["data_type"] = "Byte"
+    config["distribution_parameters"] = {"a": 1, "b": 6}
+
+    ds = open_config(config, "/vsimem/uniform_integer_dice.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray()
+
+    counts = np.bincount(data.ravel(), minlength=7)
+    assert counts[0] == 0
+    expected = data.size / 6
+    assert np.all(np.abs(counts[1:] - expected) < 5 * np.sqrt(expected))
+
+@pytest.mark.parametrize("data_type,a,b", [
+    ("Byte", 0, 255),
+    ("Byte", 0, 199),
+    ("Int16", -1000, 1000),
+    ("UInt16", 0, 65535)])
+def test_uniform_integer_unbiased_narrow(open_config, uniform_integer_json, data_type, a, b):
+    """Narrow ranges slice each engine draw into several values, these must stay unbiased."""
+    config = uniform_integer_json.copy()
+    config["rows"] = 1000
+    config["cols"] = 1000
+    config["data_type"] = data_type
+    config["distribution_parameters"] = {"a": a, "b": b}
+
+    ds = open_config(config, "/vsimem/uniform_integer_narrow.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray().astype(np.int64)
+
+    assert data.min() >= a
+    assert data.max() <= b
+    counts = np.bincount((data - a).ravel(), minlength=b - a + 1)
+    expected = data.size / (b - a + 1)
+    chi_squared = np.sum((counts - expected) ** 2 / expected)
+    degrees = b - a
+    assert abs(chi_squared - degrees) < 6 * np.sqrt(2 * degrees)
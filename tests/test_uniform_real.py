@@ -0,0 +1,40 @@
+import numpy as np
+import pytest
+from osgeo import gdal
+
+@pytest.fixture
+def uniform_real_json():
+    """Provides a standard JSON configuration for a uniform real raster."""
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": 200,
+        "cols": 300,
+        "data_type": "Float32",
+        "seed": 321,
+        "distribution": "uniform_real",
+        "distribution_parameters": {
+            "a": -2.5,
+            "b": 7.5
+        }
+    }
+
+@pytest.mark.parametrize("data_type", ["Float32", "Float64"])
+def test_uniform_real_range_and_moments(open_config, uniform_real_json, data_type):
+    """Verify that values lie in [a, b] with the mean and variance of a uniform distribution."""
+    uniform_real_json["data_type"] = data_type
+    vsi_filename = "/vsimem/uniform_real_params.json"
+
+    ds = open_config(uniform_real_json, vsi_filename)
+    assert ds is not None, "GDAL could not open the dataset from the virtual file."
+    band = ds.GetRasterBand(1)
+    assert band.DataType == gdal.GetDataTypeByName(data_type)
+
+    data = band.ReadAsArray().astype(np.float64)
+    assert np.all(data >= -2.5)
+    assert np.all(data <= 7.5)
+    assert abs(data.mean() - 2.5) < 0.05
+    assert abs(data.std() - 10.0 / np.sqrt(12.0)) < 0.05
+
+    ds2 = open_config(uniform_real_json, vsi_filename)
+    data2 = ds2.GetRasterBand(1).ReadAsArray().astype(np.float64)
+    assert np.array_equal(data, data2), "Data should be reproducible with the same seed."
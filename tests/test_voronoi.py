@@ -0,0 +1,65 @@
+import numpy as np
+import pytest
+
+def voronoi_config(block_size=64, data_type="Byte", rows=400, cols=300, **parameters):
+    parameters.setdefault("weights", [1.0, 2.0, 0.0, 1.0])
+    return {
+        "type": "RANDOM_RASTER",
+        "rows": rows,
+        "cols": cols,
+        "block_rows": block_size,
+        "block_cols": block_size,
+        "data_type": data_type,
+        "seed": 5,
+        "distribution": "voronoi",
+        "distribution_parameters": parameters
+    }
+
+def test_classes_and_patches(open_config):
+    ds = open_config(voronoi_config(rows=1000, cols=1000, cell_size=10.0), "/vsimem/voronoi.json")
+    assert ds is not None
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert set(np.unique(data)) <= {0, 1, 3}
+    # About 10000 patches, so the fractions are close to the weights.
+    fractions = np.array([np.mean(data == k) for k in range(4)])
+    assert np.allclose(fractions, [0.25, 0.5, 0.0, 0.25], atol=0.03)
+    # Cells form contiguous patches.
+    assert np.mean(data[:, :-1] == data[:, 1:]) > 0.8
+    assert np.mean(data[:-1, :] == data[1:, :]) > 0.8
+
+def test_statistics_from_weights(open_config):
+    band = open_config(voronoi_config(), "/vsimem/statistics.json").GetRasterBand(1)
+    minimum, maximum, mean, std_dev = band.GetStatistics(False, True)
+    assert minimum == 0.0 and maximum == 3.0
+    assert mean == pytest.approx(1.25)
+    assert std_dev == pytest.approx(np.sqrt(0.25 * 1.25**2 + 0.5 * 0.25**2 + 0.25 * 1.75**2))
+
+def test_does_not_depend_on_blocks_or_windows(open_config):
+    a = open_config(voronoi_config(64), "/vsimem/a.json").GetRasterBand(1)
+    b = open_config(voronoi_config(50), "/vsimem/b.json").GetRasterBand(1)
+    full = a.ReadAsArray()
+    assert np.array_equal(full, b.ReadAsArray())
+    assert np.array_equal(a.ReadAsArray(17, 93, 41, 7), full[93:100, 17:58])
+
+def test_overviews(open_config, nearest):
+    """Overview pixels are the nearest pixels of the base band."""
+    band = open_config(voronoi_config(32), "/vsimem/overviews.json").GetRasterBand(1)
+    assert band.GetOverviewCount() > 0
+    full = band.ReadAsArray()
+    for i in range(band.GetOverviewCount()):
+        overview = band.GetOverview(i)
+        expected = full[np.ix_(nearest(400, overview.YSize), nearest(300, overview.XSize))]
+        assert np.array_equal(overview.ReadAsArray(), expected)
+
+def test_square_patches_without_jitter(open_config):
+    config = voronoi_config(cell_size=20.0, jitter=0.0, weights=[1.0] * 50)
+    data = open_config(config, "/vsimem/squares.json").GetRasterBand(1).ReadAsArray()
+    for r in range(0, 400, 20):
+        for c in range(0, 300, 20):
+            assert np.all(data[r:r + 20, c:c + 20] == data[r, c])
+
+@pytest.mark.parametrize("parameters", [
+    {"weights": []}, {"weights": [0.0, 0.0]}, {"weights": [1.0, -1.0]},
+    {"cell_size": 0.0}, {"cell_size": 0.5}, {"jitter": 1.5}])
+def test_invalid_parameters(open_config, parameters):
+    assert open_config(voronoi_config(**parameters), "/vsimem/invalid.json") is None